@@ -19,6 +19,12 @@ namespace HelixSolver
         double xBegin;
         double yBegin;
         uint32_t divisionLevel = 0; // number of divisions needed from the original acc
+        // lines which can cross this section, i.e. the ones crossing its parent,
+        // stored in candidates arena of the work-item, ALL_CANDIDATES means all lines of the wedge
+        static constexpr uint32_t ALL_CANDIDATES = UINT32_MAX;
+        uint32_t candidatesBegin = ALL_CANDIDATES;
+        uint32_t candidatesCount = 0;
+        inline bool usesAllCandidates() const { return candidatesBegin == ALL_CANDIDATES; }
         int32_t indices[MAX_COUNT_PER_SECTION];
         uint16_t counts = 0;
         int8_t OUT_OF_RANGE_COUNTS = 111;
@@ -6,6 +6,7 @@
 #include "Debug/Debug.h"
 #include "HelixSolver/EventBuffer.h"
 #include "HelixSolver/AccumulatorSection.h"
+#include "HelixSolver/CompactSection.h"
 #include "HelixSolver/Options.h"
 #include "HelixSolver/ZPhiPartitioning.h"
 
@@ -14,40 +15,86 @@
 using FloatBufferReadAccessor = sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device>;
 using SolutionsWriteAccessor = sycl::accessor<HelixSolver::SolutionCircle, 1, sycl::access::mode::write, sycl::access::target::device>;
 using OptionsAccessor = sycl::accessor<HelixSolver::Options, 1, sycl::access::mode::read, sycl::access::target::device>;
+using SolutionsCounterAccessor = sycl::accessor<uint32_t, 1, sycl::access::mode::read_write, sycl::access::target::device>;
 using Index2D = sycl::id<2>;
 #else
 #include <vector>
 #include <array>
-using FloatBufferReadAccessor = const FloatBuffer &;
+using FloatBufferReadAccessor = const float *;
 using SolutionsWriteAccessor = std::vector<HelixSolver::SolutionCircle> &;
 using Index2D = std::array<int, 2>;
 using OptionsAccessor = const OptionsBuffer &;
+using SolutionsCounterAccessor = SolutionsCounterBuffer &;
 #define SYCL_EXTERNAL
 #endif
 
 namespace HelixSolver
 {
+    // Steps of the adaptive Hough transform shared by the kernels of all modes (ComputingWorker::AdaptiveKernelMode),
+    // together with accessors of the event and of its solutions
     class AdaptiveHoughGpuKernel
     {
     public:
-        AdaptiveHoughGpuKernel(OptionsAccessor o, FloatBufferReadAccessor rs, FloatBufferReadAccessor phis, FloatBufferReadAccessor z, SolutionsWriteAccessor solution);
+        // as and bs are per spacepoint line parameters computed by LineParametersKernel
+        // buffers can be larger than the event, only first spacepointsCount entries are used
+        AdaptiveHoughGpuKernel(OptionsAccessor o, uint32_t spacepointsCount, FloatBufferReadAccessor rs, FloatBufferReadAccessor phis, FloatBufferReadAccessor z, FloatBufferReadAccessor as, FloatBufferReadAccessor bs, SolutionsWriteAccessor solution, SolutionsCounterAccessor solutionsCounter);
 
-        SYCL_EXTERNAL void operator()(Index2D idx) const;
+        // size of the initial accumulator section of every work-item
+        static void getInitialSectionSize(const Options &opt, float &xSize, float &ySize);
+        // number of division levels of the accumulator down to the precision given in options, including the initial one
+        static uint32_t getDivisionLevelsCount(const Options &opt);
 
     private:
-        void fillAccumulatorSection(AccumulatorSection *sectionsStack, uint32_t &sectionsHeight, float* rs_wedge, float* phis_wedge, float* zs_wedge, float wedge_phi_center, float wedge_eta_center, uint32_t wedge_spacepoints_count) const;
-        uint16_t countHits(AccumulatorSection &section, float* rs_wedge, float* phis_wedge, float* zs_wedge, uint32_t wedge_spacepoints_count) const;
-        uint16_t countHits_checkOrder(AccumulatorSection &section, const float* rs_wedge, const float* phis_wedge, const float* zs_wedge, const uint32_t wedge_spacepoints_count) const;
+        // DepthFirstHoughKernel runs the per section steps for the sections of a wedge kept on a stack,
+        // AdaptiveHoughGroupKernel runs them with lines counted by the whole work-group,
+        // kernels of the section queue and frontier modes run them for sections of all wedges kept in device memory,
+        // StacklessHoughKernel walks the sections of a wedge without the sections stack
+        friend class DepthFirstHoughKernel;
+        friend class AdaptiveHoughGroupKernel;
+        friend class WedgePointsKernel;
+        friend class SectionQueueKernel;
+        friend class FrontierKernel;
+        friend class StacklessHoughKernel;
+
+        // wedge and the initial accumulator section processed by work-item idx
+        struct WorkRegion
+        {
+            Wedge wedge;
+            float wedgePhiCenter;
+            float wedgeEtaCenter;
+            AccumulatorSection initialSection;
+        };
+
+        WorkRegion getWorkRegion(Index2D idx) const;
+        // returns false when the spacepoint is outside the wedge, phi and b are shifted for wedges wrapping around +-PI
+        bool readWedgeSpacepoint(const Wedge &wedge, uint32_t index, float &r, float &phi, float &a, float &b) const;
+        // sections on the stack are parts of initialSection, the initial section of the work-item,
+        // candidates arena holds candidatesCapacity entries, without it (nullptr) all sections are tested against all lines of the wedge
+        void fillAccumulatorSection(CompactSection *sectionsStack, uint32_t &sectionsHeight, const AccumulatorSection &initialSection, uint32_t* candidates, uint32_t &candidatesTop, uint32_t candidatesCapacity, float* rs_wedge, float* phis_wedge, float* as_wedge, float* bs_wedge, float wedge_phi_center, float wedge_eta_center, uint32_t wedge_spacepoints_count) const;
+        bool isAboveThreshold(const AccumulatorSection &section, uint16_t count) const;
+        // children of the section share the given candidates list, returns false when the section is not split any more,
+        // section is the geometry of compactSection
+        bool pushChildren(CompactSection *sectionsStack, uint32_t &sectionsHeight, const CompactSection &compactSection, const AccumulatorSection &section, uint32_t childrenCandidatesBegin, uint32_t childrenCandidatesCount) const;
+        // first child of the section along the Z-order curve, split as in pushChildren, returns false when the section is not split any more
+        bool firstChild(const CompactSection &compactSection, const AccumulatorSection &section, CompactSection &child) const;
+        // all lines crossing the section are recorded in candidates starting from candidatesTop (if they fit and candidates is not nullptr),
+        // their number is returned in crossingCount
+        uint16_t countHits(AccumulatorSection &section, uint32_t* candidates, uint32_t candidatesTop, uint32_t candidatesCapacity, uint32_t &crossingCount, const float* as_wedge, const float* bs_wedge, uint32_t wedge_spacepoints_count) const;
+        uint16_t countHits_checkOrder(AccumulatorSection &section, const uint32_t* candidates, const float* phis_wedge, const float* as_wedge, const float* bs_wedge, const uint32_t wedge_spacepoints_count) const;
+        void addSolutionIfPeak(AccumulatorSection &section, float* rs_wedge, float* phis_wedge, const float* as_wedge, const float* bs_wedge, uint32_t wedge_spacepoints_count, float wedge_phi_center, float wedge_eta_center) const;
         void addSolution(const AccumulatorSection& section, float wedge_phi_center, float wedge_eta_center) const;
         void fillPreciseSolution(const AccumulatorSection& section, SolutionCircle& s) const;
-        bool lineInsideAccumulator(const float radius_inverse, const float phi) const;
-        bool isPeakWithinCell(AccumulatorSection &section, float* rs_wedge, float* phis_wedge, float* zs_wedge, uint32_t wedge_spacepoints_count) const;
+        bool isPeakWithinCell(AccumulatorSection &section, float* rs_wedge, float* phis_wedge, const float* as_wedge, const float* bs_wedge, uint32_t wedge_spacepoints_count) const;
 
         OptionsAccessor opts;
+        uint32_t spacepointsCount;
         FloatBufferReadAccessor rs;
         FloatBufferReadAccessor phis;
         FloatBufferReadAccessor zs;
+        FloatBufferReadAccessor as;
+        FloatBufferReadAccessor bs;
         SolutionsWriteAccessor solutions;
+        SolutionsCounterAccessor solutionsCounter;
     };
 
 } // namespace HelixSolver
\ No newline at end of file
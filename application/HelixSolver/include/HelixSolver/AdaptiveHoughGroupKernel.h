@@ -0,0 +1,70 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/WedgePoints.h"
+#include "HelixSolver/WorkGroup.h"
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+using LocalFloatAccessor = sycl::local_accessor<float, 1>;
+using LocalIndexAccessor = sycl::local_accessor<uint32_t, 1>;
+using LocalSectionAccessor = sycl::local_accessor<HelixSolver::AccumulatorSection, 1>;
+using GroupItem2D = sycl::nd_item<2>;
+#else
+using GroupItem2D = Index2D;
+#endif
+
+namespace HelixSolver
+{
+    // Variant of AdaptiveHoughGpuKernel where a work-group processes a wedge instead of a single work-item,
+    // launched with nd_range of WORK_GROUP_SIZE x 1 groups, one per (phi, eta) index of AdaptiveHoughGpuKernel,
+    // after WedgePointsKernel. All work-items walk the same sections. Lines tested for a section are staged in
+    // local memory in tiles of GROUP_TILE_SIZE, each tile is tested by all work-items and the results combined
+    // with group scans and reductions, so wedges of any size are processed by the whole group. Final sections
+    // are collected in local memory and checked for peaks in batches, one section per work-item.
+    class AdaptiveHoughGroupKernel
+    {
+    public:
+#ifdef USE_SYCL
+        AdaptiveHoughGroupKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, sycl::handler &handler);
+#else
+        AdaptiveHoughGroupKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points);
+#endif
+
+        SYCL_EXTERNAL void operator()(GroupItem2D item) const;
+
+    private:
+        // pointers to the local memory of the group
+        struct GroupMemory
+        {
+            uint32_t *candidates;
+            uint32_t *tileIndices;
+            float *tilePhis;
+            float *tileAs;
+            float *tileBs;
+            uint32_t *sectionLines; // first lines crossing the section
+            AccumulatorSection *peaks;
+        };
+
+        // copies tileSize lines of the section starting from tileBegin to the tile
+        void stageTile(const WorkGroup &group, const GroupMemory &memory, const AccumulatorSection &section, uint32_t tileBegin, uint32_t tileSize, const float *phis_wedge, const float *as_wedge, const float *bs_wedge) const;
+        // as AdaptiveHoughGpuKernel::countHits
+        uint16_t countHits(const WorkGroup &group, const GroupMemory &memory, AccumulatorSection &section, uint32_t candidatesTop, uint32_t &crossingCount, const float *phis_wedge, const float *as_wedge, const float *bs_wedge, uint32_t wedge_spacepoints_count) const;
+        // as AdaptiveHoughGpuKernel::countHits_checkOrder, lines it takes are found by the group, the rest is done by the first work-item
+        uint16_t countHits_checkOrder(const WorkGroup &group, const GroupMemory &memory, AccumulatorSection &section, const float *phis_wedge, const float *as_wedge, const float *bs_wedge, uint32_t wedge_spacepoints_count) const;
+        // checks the collected final sections and adds solutions for the ones having peaks
+        void checkPeaks(const WorkGroup &group, const GroupMemory &memory, uint32_t peaksCount, float *rs_wedge, float *phis_wedge, const float *as_wedge, const float *bs_wedge, uint32_t wedge_spacepoints_count, float wedge_phi_center, float wedge_eta_center) const;
+
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+#ifdef USE_SYCL
+        LocalIndexAccessor candidates;
+        LocalIndexAccessor tileIndices;
+        LocalFloatAccessor tilePhis;
+        LocalFloatAccessor tileAs;
+        LocalFloatAccessor tileBs;
+        LocalIndexAccessor sectionLines;
+        LocalSectionAccessor peaks;
+#endif
+    };
+} // namespace HelixSolver
@@ -1,9 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "HelixSolver/Event.h"
+#include "HelixSolver/ComputingManager.h"
 #include "HelixSolver/ComputingWorker.h"
+#include "HelixSolver/RZFilter.h"
+#include "ThreadPool/BlockingQueue.h"
+
+class TTree;
 
 namespace HelixSolver
 {
@@ -15,15 +24,62 @@ namespace HelixSolver
         void run();
 
     private:
+        using EventsQueue = ThreadPool::BlockingQueue<std::shared_ptr<Event>>;
+
+        // consecutive entries of one event read from a range of the input tree
+        struct EventPoints
+        {
+            Event::EventId eventId;
+            std::vector<float> xs;
+            std::vector<float> ys;
+            std::vector<float> zs;
+            bool takeIt;
+        };
+
+        struct SpacepointsSelection
+        {
+            // sorted, all events are selected when neither eventIds nor eventsRange are set
+            std::optional<std::vector<Event::EventId>> eventIds;
+            // first and last selected id, both included
+            std::optional<std::pair<Event::EventId, Event::EventId>> eventsRange;
+            RZFilter rzFilter;
+
+            bool selectsAll() const;
+            bool selects(Event::EventId eventId) const;
+        };
 
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> loadEvents(const std::string& path) const;
+        // pushes events to the queue as they are read and closes it at the end of input
+        void loadEvents(const std::string& path, EventsQueue& events) const;
         void runOnCpu() const;
         void runOnGpu() const;
+        // computes events from the input file, or serves them when runAsService is set in config
+        void processEvents(ComputingManager& computingManager) const;
+        // reads input and writes solutions on separate threads, events are computed as soon as they are read
+        void computeEvents(ComputingManager& computingManager) const;
+        // events are read from a shared memory ring and solutions written to another one until the client closes
+        // the events ring, the computing manager and its queues stay initialised between events
+        void serveEvents(ComputingManager& computingManager) const;
 
         static ComputingWorker::Platform getPlatformFromString(const std::string& platformStr);
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> loadEventsFromSpacepointsRootFile(const std::string& path) const;
-        static void saveSolutionsInRootFile(const std::unique_ptr<std::vector<ComputingWorker::EventSoutionsPair>>& eventsAndSolutions, const std::string& path);
-        std::function<bool(float, float, float)> selector (const std::string& settingName, bool defaultDecision = false) const;
+        // entry ranges of the tree are read concurrently, events split between ranges are merged
+        void loadEventsFromSpacepointsRootFile(const std::string& path, EventsQueue& events) const;
+        static std::vector<std::pair<int64_t, int64_t>> splitIntoEntryRanges(TTree& hitsTree, uint32_t readerThreads);
+        // only entries of the selected events are read, they are found with the index stored next to the input file
+        static std::vector<std::pair<int64_t, int64_t>> findEntryRanges(const std::string& path, TTree& hitsTree, const SpacepointsSelection& selection);
+        static std::vector<EventPoints> readSpacepointsRootEntries(const std::string& path, int64_t begin, int64_t end, const SpacepointsSelection& selection);
+        // file written by SpacepointsConverter, events view the mapped file unless some of their points are excluded
+        void loadEventsFromSpacepointsBinaryFile(const std::string& path, EventsQueue& events) const;
+        // path is a directory of per-event files (e.g. event000000042-spacepoint.csv), files are parsed concurrently
+        void loadEventsFromSpacepointsCsvDirectory(const std::string& path, EventsQueue& events) const;
+        // returns nullptr when the event is excluded
+        static std::shared_ptr<Event> readSpacepointsCsvFile(const std::string& path, Event::EventId eventId, const SpacepointsSelection& selection);
+        bool pushEvent(std::shared_ptr<Event> event, EventsQueue& events) const;
+        // event, events or eventsRange from config, selection is not accessed from config by reader threads,
+        // throws std::invalid_argument when eventsRange is not [first, last] with first <= last
+        SpacepointsSelection spacepointsSelection() const;
+        // excludeRZRegions and excludeEventsWithHitsInRZ from config
+        RZFilter rzFilter() const;
+        std::vector<RZFilter::Region> rzRegions(const std::string& settingName) const;
 
         void loadConfig(const std::string& configFilePath);
     };
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "HelixSolver/AccumulatorSection.h"
+
+namespace HelixSolver
+{
+    // Section of the accumulator identified by its place in the tree of divisions of the initial section of a
+    // work-item. Every division halves the section along x, y or both, xDepth and yDepth count the halvings
+    // along each axis and the section is the (x, y) cell of the 2^xDepth x 2^yDepth grid over the initial one.
+    // The cell is stored as Morton (Z-order) index, interleaved bits of x and y, so sections of a level sort
+    // along the curve and equal ones compare equal. Geometry is computed from the initial section when needed.
+    class CompactSection
+    {
+    public:
+        uint64_t mortonIndex = 0;
+        uint8_t divisionLevel = 0;
+        uint8_t xDepth = 0;
+        uint8_t yDepth = 0;
+        // as in AccumulatorSection
+        uint32_t candidatesBegin = AccumulatorSection::ALL_CANDIDATES;
+        uint32_t candidatesCount = 0;
+
+        uint32_t getX() const { return compactBits(mortonIndex >> 1); }
+        uint32_t getY() const { return compactBits(mortonIndex); }
+
+        // sub-section of this one, xHalf and yHalf tell whether the axis is split and which half is taken
+        enum class Half : uint8_t
+        {
+            WHOLE,
+            LOWER,
+            UPPER
+        };
+        CompactSection child(Half xHalf, Half yHalf) const
+        {
+            uint32_t x = getX();
+            uint32_t y = getY();
+            CompactSection section = *this;
+            if (xHalf != Half::WHOLE)
+            {
+                x = 2 * x + (xHalf == Half::UPPER ? 1 : 0);
+                ++section.xDepth;
+            }
+            if (yHalf != Half::WHOLE)
+            {
+                y = 2 * y + (yHalf == Half::UPPER ? 1 : 0);
+                ++section.yDepth;
+            }
+            section.mortonIndex = (spreadBits(x) << 1) | spreadBits(y);
+            ++section.divisionLevel;
+            return section;
+        }
+
+        // Whether the division which made this section split x (y). Axes are split while the section is larger
+        // than the precision, so an axis split at some level was split at all the levels above, and it was
+        // split by the last division exactly when its depth equals the division level.
+        bool isXSplit() const { return divisionLevel > 0 && xDepth == divisionLevel; }
+        bool isYSplit() const { return divisionLevel > 0 && yDepth == divisionLevel; }
+
+        // inverse of child, the section must not be the initial one
+        CompactSection parent() const
+        {
+            uint32_t x = getX();
+            uint32_t y = getY();
+            CompactSection section = *this;
+            if (isXSplit())
+            {
+                x /= 2;
+                --section.xDepth;
+            }
+            if (isYSplit())
+            {
+                y /= 2;
+                --section.yDepth;
+            }
+            section.mortonIndex = (spreadBits(x) << 1) | spreadBits(y);
+            --section.divisionLevel;
+            return section;
+        }
+
+        // children of a section are ordered along the Z-order curve, lower halves first and y before x
+        bool isLastChild() const
+        {
+            return (!isXSplit() || (getX() & 1)) && (!isYSplit() || (getY() & 1));
+        }
+
+        // the child of the same parent following this one, the section must not be the last child
+        CompactSection nextSibling() const
+        {
+            uint32_t x = getX();
+            uint32_t y = getY();
+            CompactSection section = *this;
+            if (isYSplit() && !(y & 1))
+            {
+                ++y;
+            }
+            else
+            {
+                if (isYSplit())
+                    --y;
+                ++x;
+            }
+            section.mortonIndex = (spreadBits(x) << 1) | spreadBits(y);
+            return section;
+        }
+
+        AccumulatorSection toSection(const AccumulatorSection &initialSection) const
+        {
+            // sizes are halved exactly, begins are the same as of the sections split one by one up to rounding
+            const double xSize = initialSection.xSize / static_cast<double>(uint64_t(1) << xDepth);
+            const double ySize = initialSection.ySize / static_cast<double>(uint64_t(1) << yDepth);
+            AccumulatorSection section(xSize, ySize, initialSection.xBegin + getX() * xSize, initialSection.yBegin + getY() * ySize, divisionLevel);
+            section.candidatesBegin = candidatesBegin;
+            section.candidatesCount = candidatesCount;
+            return section;
+        }
+
+    private:
+        // bits of value at even positions
+        static uint64_t spreadBits(uint32_t value)
+        {
+            uint64_t bits = value;
+            bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+            bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+            bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+            bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+            return bits;
+        }
+
+        // inverse of spreadBits, bits at odd positions are dropped
+        static uint32_t compactBits(uint64_t bits)
+        {
+            bits &= 0x5555555555555555ull;
+            bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+            bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+            bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+            bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+            bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+            return static_cast<uint32_t>(bits);
+        }
+    };
+} // namespace HelixSolver
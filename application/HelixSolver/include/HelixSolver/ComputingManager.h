@@ -1,5 +1,9 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <queue>
 
 #include "HelixSolver/ComputingWorker.h"
@@ -11,26 +15,43 @@ namespace HelixSolver
     {
     public:
         ComputingManager(ComputingWorker::Platform platform, uint32_t numBuffers, uint32_t numWorkers);
+        ~ComputingManager();
 
         bool addEvent(std::shared_ptr<Event> event);
         void waitUntillAllTasksCompleted();
-        void waitForWaitingWorker();
+        // blocks until at least one processing worker completes and its buffer is released, returns at once if nothing is processed
+        void waitForAnyCompletion();
         std::unique_ptr<std::vector<ComputingWorker::EventSoutionsPair>> transferSolutions();
+        // when set, solutions of completed events are passed to the consumer instead of being kept for transferSolutions
+        void setSolutionsConsumer(std::function<void(ComputingWorker::EventSoutionsPair&&)> consumer);
         void update();
 
     private:
         void startProcessingReadyBuffers();
         void transferSolutionsFromCompletedWorkers();
+        bool anyProcessingWorkerCompleted() const;
+        // prefers a buffer already holding columns of the event, so that replicas reuse their upload
+        std::deque<uint32_t>::iterator selectFreeEventBuffer(const Event &event);
+        void notifyCompletion();
         std::unique_ptr<Queue> getNewQueue() const;
 
         ComputingWorker::Platform platform;
+#ifndef USE_SYCL
+        // shared by queues of all workers, so that wedges of one event can be spread over all cores
+        std::shared_ptr<ThreadPool::WorkStealingThreadPool> threadPool;
+#endif
+        // largest capacity requested so far, an event buffer is grown to it when it is selected for an event
+        uint32_t spacepointsCapacity = 0;
         std::vector<std::shared_ptr<EventBuffer>> eventBuffers;
         std::vector<std::shared_ptr<ComputingWorker>> computingWorkers;
         std::unique_ptr<std::vector<ComputingWorker::EventSoutionsPair>> solutions;
-        std::queue<uint32_t> freeEventBuffers;
+        std::function<void(ComputingWorker::EventSoutionsPair&&)> solutionsConsumer;
+        std::deque<uint32_t> freeEventBuffers;
         std::queue<uint32_t> readyEventBuffers;
         std::vector<uint32_t> processedEventBuffers;
         std::queue<uint32_t> waitingComputingWorkers;
         std::vector<uint32_t> processingComputingWorkers;
+        std::mutex completionMutex;
+        std::condition_variable completionCondition;
     };
 } // namespace HelixSolver
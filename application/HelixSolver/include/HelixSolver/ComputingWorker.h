@@ -1,8 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include <string>
+
 #include "HelixSolver/EventBuffer.h"
 #include "HelixSolver/SolutionCircle.h"
 #include "HelixSolver/ProcessingQueue.h"
+#include "HelixSolver/Options.h"
+#include "HelixSolver/FrontierKernel.h"
+#include "HelixSolver/SectionQueueKernel.h"
+#include "HelixSolver/WedgePoints.h"
 namespace HelixSolver
 {
     class ComputingWorker
@@ -25,13 +33,28 @@ namespace HelixSolver
             FPGA_EMULATOR=5
         };
 
+        // how the adaptive Hough transform is parallelised, set with adaptiveKernelMode config property
+        enum class AdaptiveKernelMode
+        {
+            DEPTH_FIRST,   // a work-item per wedge, see DepthFirstHoughKernel
+            WORK_GROUP,    // a work-group per wedge, see AdaptiveHoughGroupKernel
+            SECTION_QUEUE, // sections of all wedges shared by persistent work-items, see SectionQueueKernel
+            FRONTIER,      // sections of all wedges processed a division level at a time, see FrontierKernel
+            STACKLESS      // a work-item per wedge walking its sections without a stack, see StacklessHoughKernel
+        };
+
         using EventSoutionsPair = std::pair<std::shared_ptr<Event>, std::unique_ptr<std::vector<SolutionCircle>>>;
 
         ComputingWorkerState updateAndGetState();
         void setState(ComputingWorkerState state);
         bool assignBuffer(std::shared_ptr<EventBuffer> eventBuffer);
         ComputingWorker(std::unique_ptr<Queue>&& queue);
+        ~ComputingWorker();
         const Queue* getQueue() const;
+        // callback is invoked from the thread completing the event, it must be cheap and thread safe
+        void setCompletionCallback(std::function<void()> callback);
+        // safe to call from any thread, unlike updateAndGetState
+        bool isCompleted() const;
 
         EventSoutionsPair transferSolutions();
         void waitUntillCompleted();
@@ -39,12 +62,37 @@ namespace HelixSolver
     private:
         void updateState();
         void scheduleTasksToQueue();
+        void markCompleted();
+#ifndef USE_SYCL
+        // runs task(index) for indices below count in parallel tasks, the last of them calls completion
+        void submitTasks(uint32_t count, uint32_t tasksSize, std::function<void(uint32_t)> task, std::function<void()> completion);
+        // a task per work region, for the modes launched with a work-item (or work-group) per region
+        void scheduleRegionTasks(const AdaptiveHoughGpuKernel &kernel);
+        void scheduleSectionQueueTasks(const AdaptiveHoughGpuKernel &kernel);
+        void scheduleFrontierLevelTasks(const AdaptiveHoughGpuKernel &kernel, uint32_t level);
+#endif
+        static AdaptiveKernelMode getAdaptiveKernelModeFromString(const std::string& modeStr);
 
         ComputingWorkerState state = ComputingWorkerState::WAITING;
         std::shared_ptr<EventBuffer> eventBuffer = nullptr; // ?
         std::unique_ptr<std::vector<SolutionCircle>> solutions;
+        Options options;
+        AdaptiveKernelMode adaptiveKernelMode = AdaptiveKernelMode::DEPTH_FIRST;
+        std::unique_ptr<OptionsBuffer> optionsBuffer;
         std::unique_ptr<SolutionBuffer> solutionsBuffer;
+        std::unique_ptr<SolutionsCounterBuffer> solutionsCounterBuffer;
         std::unique_ptr<Queue> queue;
+        // memory of the wedge points read by all modes, of SECTION_QUEUE and FRONTIER modes, uses the queue
+        std::unique_ptr<WedgePointsStorage> wedgePointsStorage;
+        std::unique_ptr<SectionQueueStorage> sectionQueueStorage;
+        std::unique_ptr<FrontierStorage> frontierStorage;
+        uint32_t frontierLevelsCount = 0;
+        std::atomic<bool> completed = false;
+        std::function<void()> completionCallback;
+
+#ifndef USE_SYCL
+        std::atomic<uint32_t> pendingWorkItems = 0;
+#endif
 
 #ifdef USE_SYCL
         sycl::event computingEvent;
@@ -40,12 +40,70 @@ static constexpr float ACC_Y_SIZE = Q_OVER_PT_END - Q_OVER_PT_BEGIN;
 // single pion: spacepoints = 20, solutions = 300(0) (when using division), 100 witoud divisions
 static constexpr uint32_t MAX_SPACEPOINTS = 50000;
 static constexpr uint32_t MAX_SOLUTIONS   = 600000; // an arbitrary size, need to get it experimentally (ideally configurable)
+// events read ahead of computation, can be changed with inputEventsQueueDepth config property
+static constexpr uint32_t DEFAULT_INPUT_EVENTS_QUEUE_DEPTH = 64;
+// ROOT input is split into about this many entry ranges per reader thread (inputReaderThreads config property)
+static constexpr uint32_t INPUT_ENTRY_RANGES_PER_THREAD = 4;
+static constexpr int64_t INPUT_TREE_CACHE_SIZE = 64 * 1024 * 1024;
+// solutions of events computed but not yet written, can be changed with outputEventsQueueDepth config property
+static constexpr uint32_t DEFAULT_OUTPUT_EVENTS_QUEUE_DEPTH = 64;
+static constexpr uint32_t SOLUTIONS_AUTOSAVE_EVENTS = 100;
+// shared memory rings of the service mode (runAsService config property), can be changed with serviceEventsRing,
+// serviceResultsRing, serviceRingSlots and serviceMaxSolutions config properties
+static constexpr char DEFAULT_SERVICE_EVENTS_RING[] = "/helix_solver_events";
+static constexpr char DEFAULT_SERVICE_RESULTS_RING[] = "/helix_solver_results";
+static constexpr uint32_t DEFAULT_SERVICE_RING_SLOTS = 16;
+// solutions passed to the client per event, the overflow flag of the result is set for events with more of them
+static constexpr uint32_t DEFAULT_SERVICE_MAX_SOLUTIONS = 16384;
+static constexpr uint32_t SERVICE_POLL_INTERVAL_US = 50;
+// spacepoints tested against r-z regions at once by RZFilter
+static constexpr uint32_t RZ_FILTER_BLOCK_SIZE = 256;
+// event buffers grow in steps of this size, so that slightly larger events do not trigger reallocation
+static constexpr uint32_t SPACEPOINTS_CAPACITY_GRANULARITY = 4096;
+// replica i of an event multiplied with multiplyEvents config property gets id + i * REPLICATED_EVENTS_ID_STRIDE
+static constexpr uint32_t REPLICATED_EVENTS_ID_STRIDE = 1 << 22;
+
+// layout of the solutions counter buffer, kernel appends solutions at atomically incremented
+// count and raises overflow flag instead of writing beyond MAX_SOLUTIONS
+static constexpr uint32_t SOLUTIONS_COUNT_INDEX = 0;
+static constexpr uint32_t SOLUTIONS_OVERFLOW_INDEX = 1;
+static constexpr uint32_t SOLUTIONS_COUNTER_SIZE = 2;
 
 // Initial division parameters
 //static constexpr uint8_t ADAPTIVE_KERNEL_INITIAL_DIVISION_LEVEL = 20; // this gives parallelism
-static constexpr uint8_t ADAPTIVE_KERNEL_INITIAL_DIVISIONS = 1; // this is easier to debug
+static constexpr uint8_t ADAPTIVE_KERNEL_INITIAL_DIVISIONS = 1; // per wedge and axis, each division is a separate work-item
 
 static constexpr uint32_t MAX_SECTIONS_BUFFER_SIZE = 100; // need to be checked experimentally
+// arena of lines crossing the sections on the stack in the depth-first mode, a slice of the wedge points memory
+// with this many entries per point of the wedge, when exceeded children sections scan lines crossing their
+// grandparent instead (slower but still correct)
+static constexpr uint32_t WEDGE_CANDIDATES_PER_POINT = 4;
+// work-group mode of the adaptive kernel (adaptiveKernelMode config property), a work-group processes a wedge
+// copied by WedgePointsKernel, its lines are staged in local memory in tiles, the candidates arena is kept in
+// local memory too, final sections are checked for peaks in batches, one per work-item
+static constexpr uint32_t WORK_GROUP_SIZE = 64;
+static constexpr uint32_t GROUP_TILE_SIZE = 4 * WORK_GROUP_SIZE;
+static constexpr uint32_t GROUP_CANDIDATES_ARENA_SIZE = 4096;
+static constexpr uint32_t GROUP_PEAKS_BATCH_SIZE = WORK_GROUP_SIZE;
+// section queue mode of the adaptive kernel (adaptiveKernelMode config property), sections of all wedges wait
+// in a ring in device memory for persistent work-items, capacity of the ring must be a power of 2
+static constexpr uint32_t SECTION_QUEUE_CAPACITY = 1 << 18;
+// children of a section are kept by its work-item when the ring is full, when this stack is full too they are walked without a stack
+static constexpr uint32_t SECTION_QUEUE_LOCAL_STACK_SIZE = 32;
+static constexpr uint32_t SECTION_QUEUE_WORK_ITEMS_PER_COMPUTE_UNIT = 64;
+// layout of the section queue counters
+static constexpr uint32_t SECTION_QUEUE_HEAD_INDEX = 0;
+static constexpr uint32_t SECTION_QUEUE_TAIL_INDEX = 1;
+static constexpr uint32_t SECTION_QUEUE_COUNTERS_SIZE = 2;
+// frontier mode of the adaptive kernel, sections of a division level of all wedges are processed by a single launch,
+// children which do not fit the next frontier are processed depth-first by the work-item of their parent
+static constexpr uint32_t FRONTIER_CAPACITY = 1 << 16;
+static constexpr uint32_t FRONTIER_SCAN_GROUP_SIZE = 256;
+// sections processed by a task of the CPU queue
+static constexpr uint32_t FRONTIER_TASK_SIZE = 256;
+// spacepoints of all wedges are copied to device memory by WedgePointsKernel before the adaptive kernel of every mode,
+// this is the initial capacity, an event whose wedges do not fit is computed again after the memory is grown
+static constexpr uint32_t WEDGE_POINTS_CAPACITY = 8 * MAX_SPACEPOINTS;
 
 // Additional parameters
 static constexpr float MAGNETIC_INDUCTION = 2.0;
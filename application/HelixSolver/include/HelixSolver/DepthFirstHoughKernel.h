@@ -0,0 +1,23 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/WedgePoints.h"
+
+namespace HelixSolver
+{
+    // Depth-first mode of the adaptive kernel, a work-item per (phi, eta) index of AdaptiveHoughGpuKernel
+    // launched after WedgePointsKernel. Sections of the wedge are kept on a stack in private memory, points
+    // of the wedge are read from the wedge points memory, so private memory does not depend on the size of
+    // the event.
+    class DepthFirstHoughKernel
+    {
+    public:
+        DepthFirstHoughKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points);
+
+        SYCL_EXTERNAL void operator()(Index2D idx) const;
+
+    private:
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+    };
+} // namespace HelixSolver
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+using DeviceCounter = uint32_t;
+#else
+#include <atomic>
+using DeviceCounter = std::atomic<uint32_t>;
+#endif
+
+namespace HelixSolver
+{
+    // Atomic operations on counters in device memory shared by all work-items of a kernel.
+    // Without SYCL kernels run on threads of the CPU queue, counters are std::atomic.
+#ifdef USE_SYCL
+    using DeviceAtomicRef = sycl::atomic_ref<uint32_t, sycl::memory_order::acq_rel, sycl::memory_scope::device, sycl::access::address_space::global_space>;
+
+    inline uint32_t atomicLoad(DeviceCounter &counter) { return DeviceAtomicRef(counter).load(sycl::memory_order::acquire); }
+    inline void atomicStore(DeviceCounter &counter, uint32_t value) { DeviceAtomicRef(counter).store(value, sycl::memory_order::release); }
+    inline uint32_t atomicFetchAdd(DeviceCounter &counter, uint32_t value) { return DeviceAtomicRef(counter).fetch_add(value); }
+    inline uint32_t atomicFetchSub(DeviceCounter &counter, uint32_t value) { return DeviceAtomicRef(counter).fetch_sub(value); }
+    inline bool atomicCompareExchange(DeviceCounter &counter, uint32_t expected, uint32_t desired) { return DeviceAtomicRef(counter).compare_exchange_strong(expected, desired); }
+#else
+    inline uint32_t atomicLoad(DeviceCounter &counter) { return counter.load(std::memory_order_acquire); }
+    inline void atomicStore(DeviceCounter &counter, uint32_t value) { counter.store(value, std::memory_order_release); }
+    inline uint32_t atomicFetchAdd(DeviceCounter &counter, uint32_t value) { return counter.fetch_add(value, std::memory_order_acq_rel); }
+    inline uint32_t atomicFetchSub(DeviceCounter &counter, uint32_t value) { return counter.fetch_sub(value, std::memory_order_acq_rel); }
+    inline bool atomicCompareExchange(DeviceCounter &counter, uint32_t expected, uint32_t desired) { return counter.compare_exchange_strong(expected, desired, std::memory_order_acq_rel); }
+#endif
+} // namespace HelixSolver
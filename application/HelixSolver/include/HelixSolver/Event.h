@@ -1,43 +1,62 @@
 #pragma once
 
-#include <vector>
-#include <functional>
 #include <memory>
 #include <stdint.h>
-#include "HelixSolver/Point.h"
 
 namespace HelixSolver
 {
+    // Polar SoA columns of the spacepoints of one event. Columns are either held in a single arena
+    // allocated by the event or viewed in memory kept alive by an external storage (e.g. a mapped file).
     class Event
     {
     public:
         using EventId = uint32_t;
 
-        Event(EventId id, std::unique_ptr<std::vector<Point>> Points);
-        Event(const Event& other);
+        // converts cartesian coordinates into an arena, layers are set to 0
+        static Event fromCartesian(EventId id, uint32_t size, const float* xs, const float* ys, const float* zs);
+        // copies polar columns into an arena
+        static Event fromPolar(EventId id, uint32_t size, const float* rs, const float* phis, const float* zs, const uint8_t* layers);
+        // view of columns owned by storage, nothing is copied
+        Event(EventId id, uint32_t size, const float* rs, const float* phis, const float* zs, const uint8_t* layers, std::shared_ptr<const void> storage);
+        Event(const Event&) = delete;
+        Event(Event&&) = default;
+        Event& operator=(const Event&) = delete;
+        Event& operator=(Event&&) = default;
 
-        const std::vector<std::function<float(float)>>& getPointsFuncs() const;
+        // event with the given id viewing the same columns, nothing is copied
+        Event replicate(EventId replicaId) const;
 
         // TODO: fix building process and make getters inline
         EventId getId() const;
-        std::vector<float>& getR();
-        std::vector<float>& getPhi();
-        std::vector<float>& getZ();
-        std::vector<uint8_t>& getLayers();
-
-        void buildPointsFunctions();
+        uint32_t getSize() const;
+        const float* getR() const;
+        const float* getPhi() const;
+        const float* getZ() const;
+        const uint8_t* getLayers() const;
+        // owner of the columns, can be shared by other events viewing the same columns
+        const std::shared_ptr<const void>& getStorage() const;
 
         void print() const;
 
     private:
-        EventId id;
+        // arena layout: r[size], phi[size], z[size] as float followed by layer[size] as uint8_t
+        struct Arena
+        {
+            std::shared_ptr<float[]> memory;
+            float* rs;
+            float* phis;
+            float* zs;
+            uint8_t* layers;
+        };
+        static Arena allocateArena(uint32_t size);
 
-        std::unique_ptr<std::vector<Point>> Points;
-        std::vector<std::function<float(float)>> PointsFunctions;
-        std::vector<float> rs;
-        std::vector<float> phis;
-        std::vector<float> zs;
-        std::vector<uint8_t> layers;
+        EventId id;
+        uint32_t size;
+        const float* rs;
+        const float* phis;
+        const float* zs;
+        const uint8_t* layers;
+        std::shared_ptr<const void> storage;
     };
 
 } // HelixSolver
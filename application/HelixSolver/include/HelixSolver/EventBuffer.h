@@ -6,10 +6,16 @@
     #include <CL/sycl.hpp>
     using FloatBuffer=sycl::buffer<float, 1>;
     using SolutionBuffer=sycl::buffer<HelixSolver::SolutionCircle, 1>;
+    using SolutionsCounterBuffer=sycl::buffer<uint32_t, 1>;
+    // spacepoints columns are bound to the memory of the event, see EventBuffer::loadEvent
+    using SpacepointsColumn=std::shared_ptr<FloatBuffer>;
 #else
     #include <vector>
+    #include <atomic>
     using FloatBuffer=std::vector<float>;
     using SolutionBuffer=std::vector<HelixSolver::SolutionCircle>;
+    using SolutionsCounterBuffer=std::vector<std::atomic<uint32_t>>;
+    using SpacepointsColumn=const float*;
 #endif
 
 
@@ -28,17 +34,42 @@ namespace HelixSolver
 
         EventBufferState getState() const;
         void setState(EventBufferState state);
+        // columns and line parameters are kept when the event views columns already bound to the buffer (e.g. a replica)
         bool loadEvent(std::shared_ptr<Event> event);
+        bool holdsColumnsOf(const Event &event) const;
+        // false when line parameters buffers do not correspond to the columns, in SYCL builds they are computed by ComputingWorker
+        bool hasLineParameters() const;
+        void setLineParametersComputed();
+        // grows line parameters buffers so that events up to spacepointsCapacity points can be loaded without reallocation
+        void reserve(uint32_t spacepointsCapacity);
+        uint32_t getSize() const;
+        uint32_t getCapacity() const;
         std::shared_ptr<Event> getEvent();
-        std::shared_ptr<FloatBuffer> getRBuffer() const;
-        std::shared_ptr<FloatBuffer> getPhiBuffer() const;
-        std::shared_ptr<FloatBuffer> getZBuffer() const;
+        // columns of the loaded event, they are not copied on the host
+        SpacepointsColumn getRBuffer() const;
+        SpacepointsColumn getPhiBuffer() const;
+        SpacepointsColumn getZBuffer() const;
+        // slopes and intercepts of the accumulator lines, see LineParametersKernel
+        // in SYCL builds these buffers are only allocated here and filled on the device
+        // buffers can be larger than the loaded event, see getSize()
+        std::shared_ptr<FloatBuffer> getABuffer() const;
+        std::shared_ptr<FloatBuffer> getBBuffer() const;
 
     private:
+#ifdef USE_SYCL
+        static SpacepointsColumn bindColumn(const float *values, uint32_t count);
+#endif
+
         EventBufferState state = EventBufferState::FREE;
+        // declared before the columns, which view its memory
         std::shared_ptr<Event> event;
-        std::shared_ptr<FloatBuffer> rBuffer;
-        std::shared_ptr<FloatBuffer> phiBuffer;
-        std::shared_ptr<FloatBuffer> zBuffer;
+        uint32_t size = 0;
+        uint32_t capacity = 0;
+        bool lineParametersComputed = false;
+        SpacepointsColumn rBuffer = nullptr;
+        SpacepointsColumn phiBuffer = nullptr;
+        SpacepointsColumn zBuffer = nullptr;
+        std::shared_ptr<FloatBuffer> aBuffer;
+        std::shared_ptr<FloatBuffer> bBuffer;
     };
 } // namespace HelixSolver
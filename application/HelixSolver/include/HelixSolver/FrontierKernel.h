@@ -0,0 +1,102 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/LineParametersKernel.h"
+#include "HelixSolver/WedgePoints.h"
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+#else
+#include <vector>
+#endif
+
+namespace HelixSolver
+{
+    // Pointers to the memory of the frontier mode passed to its kernels. Frontier of a division level holds
+    // sections of all wedges at this level, the initial level are the work regions themselves. Frontiers of
+    // even and odd levels are kept in the two halves of sections.
+    struct FrontierView
+    {
+        RegionSection *sections;
+        uint32_t *childrenCounts;
+        uint32_t *childrenOffsets;
+        uint32_t *sizes; // sections in the frontier of every level, children which do not fit FRONTIER_CAPACITY are not counted
+
+        RegionSection *getFrontier(uint32_t level) const { return sections + (level % 2) * FRONTIER_CAPACITY; }
+    };
+
+    // memory of the frontier mode, allocated once per computing worker and reused by its events
+    class FrontierStorage
+    {
+    public:
+#ifdef USE_SYCL
+        FrontierStorage(sycl::queue &queue, uint32_t levelsCount);
+#else
+        explicit FrontierStorage(uint32_t levelsCount);
+#endif
+        ~FrontierStorage();
+        FrontierStorage(const FrontierStorage &) = delete;
+        FrontierStorage &operator=(const FrontierStorage &) = delete;
+
+        const FrontierView &getView() const;
+
+    private:
+#ifdef USE_SYCL
+        sycl::queue &queue;
+#else
+        std::vector<RegionSection> sections;
+        std::vector<uint32_t> children;
+        std::vector<uint32_t> sizes;
+#endif
+        FrontierView view;
+    };
+
+    // Processes a division level of the accumulator, a work-item per section of the level frontier. EVALUATE
+    // counts lines of the section, adds a solution for the final ones and stores the number of children of
+    // the ones which are split. EXPAND writes the children to the next frontier at offsets computed by
+    // FrontierScanKernel, children which do not fit (or would be below the last level) are processed
+    // depth-first by the work-item.
+    class FrontierKernel
+    {
+    public:
+        enum class Step
+        {
+            EVALUATE,
+            EXPAND
+        };
+
+        FrontierKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, const FrontierView &frontier, uint32_t level, bool lastLevel, Step step);
+
+        SYCL_EXTERNAL void operator()(Index1D idx) const;
+
+    private:
+        RegionSection getSection(uint32_t index) const;
+        void evaluate(uint32_t index) const;
+        void expand(uint32_t index) const;
+
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+        FrontierView frontier;
+        uint32_t level;
+        bool lastLevel;
+        Step step;
+    };
+
+    // Exclusive scan of children counts of the level into their offsets in the next frontier, run by a single
+    // work-group of FRONTIER_SCAN_GROUP_SIZE, sets the size of the next frontier.
+    class FrontierScanKernel
+    {
+    public:
+        FrontierScanKernel(const FrontierView &frontier, uint32_t level);
+
+#ifdef USE_SYCL
+        SYCL_EXTERNAL void operator()(sycl::nd_item<1> item) const;
+#else
+        void operator()() const;
+#endif
+
+    private:
+        FrontierView frontier;
+        uint32_t level;
+    };
+} // namespace HelixSolver
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "HelixSolver/Options.h"
+#include "HelixSolver/SolutionCircle.h"
+
+class PromptCPUQueue;
+
+namespace HelixSolver
+{
+    class WedgePointsStorage;
+
+    // Finds helices in a single event given as spacepoints columns in memory, without SYCL, ROOT or
+    // the configuration file. Runs the same kernels as CPU_NO_SYCL platform of the application, which
+    // makes it suitable for embedding helix finding in other programs, see HelixFinder.md.
+    // Buffers are reused between calls, a finder must not be used by several threads at once.
+    class HelixFinder
+    {
+    public:
+        // threadsCount = 1 computes on the calling thread, 0 uses all hardware threads
+        explicit HelixFinder(const Options &options, uint32_t threadsCount = 1);
+        ~HelixFinder();
+
+        // r, phi and z are columns of n spacepoints, throws std::invalid_argument when n exceeds MAX_SPACEPOINTS,
+        // at most MAX_SOLUTIONS solutions are returned, the rest is dropped
+        std::vector<SolutionCircle> findHelices(const float *r, const float *phi, const float *z, size_t n);
+
+    private:
+        std::vector<Options> options;
+        std::vector<float> as;
+        std::vector<float> bs;
+        std::vector<SolutionCircle> solutions;
+        std::vector<std::atomic<uint32_t>> solutionsCounter;
+        std::unique_ptr<WedgePointsStorage> wedgePointsStorage;
+        std::unique_ptr<PromptCPUQueue> queue;
+    };
+
+    // convenience for one off calls, computes on the calling thread
+    std::vector<SolutionCircle> findHelices(const float *r, const float *phi, const float *z, size_t n, const Options &options);
+} // namespace HelixSolver
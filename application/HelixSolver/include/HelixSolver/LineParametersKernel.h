@@ -0,0 +1,33 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+using FloatBufferWriteAccessor = sycl::accessor<float, 1, sycl::access::mode::write, sycl::access::target::device>;
+using Index1D = sycl::id<1>;
+#else
+using FloatBufferWriteAccessor = FloatBuffer &;
+using Index1D = uint32_t;
+#endif
+
+namespace HelixSolver
+{
+    // Computes parameters of the line y = ax + b traced by every spacepoint in
+    // the (phi, q/pt) accumulator: a = INVERSE_A / r, b = -a * phi.
+    // Done once per event so that the adaptive kernel does not need to
+    // recompute them for every visited accumulator section.
+    class LineParametersKernel
+    {
+    public:
+        LineParametersKernel(FloatBufferReadAccessor rs, FloatBufferReadAccessor phis, FloatBufferWriteAccessor as, FloatBufferWriteAccessor bs);
+
+        SYCL_EXTERNAL void operator()(Index1D idx) const;
+
+    private:
+        FloatBufferReadAccessor rs;
+        FloatBufferReadAccessor phis;
+        FloatBufferWriteAccessor as;
+        FloatBufferWriteAccessor bs;
+    };
+} // namespace HelixSolver
@@ -1,13 +0,0 @@
-#pragma once
-
-namespace HelixSolver
-{
-    struct Point
-    {
-        const float x;
-        const float y;
-        const float z;
-        const uint8_t layer;
-    };
-
-} // HelixSolver
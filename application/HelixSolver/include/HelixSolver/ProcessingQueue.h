@@ -2,10 +2,44 @@
 #ifdef USE_SYCL
     using Queue=sycl::queue;
 #else
-    // specimen Queue class for case when we do not use SYCL
+    #include <condition_variable>
+    #include <functional>
+    #include <memory>
+    #include <mutex>
+
+    #include "ThreadPool/WorkStealingThreadPool.h"
+
+    // Queue class for case when we do not use SYCL, tasks run on a thread pool shared by all queues
     class PromptCPUQueue {
         public:
-        void wait() {}
+        explicit PromptCPUQueue(std::shared_ptr<ThreadPool::WorkStealingThreadPool> threadPool)
+            : threadPool(std::move(threadPool)) {}
+
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++pendingTasks;
+            }
+            threadPool->submit([this, task = std::move(task)](){
+                task();
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--pendingTasks == 0) completedCondition.notify_all();
+            });
+        }
+
+        // blocks until all tasks submitted to this queue are completed
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            completedCondition.wait(lock, [this](){ return pendingTasks == 0; });
+        }
+
+        private:
+        std::shared_ptr<ThreadPool::WorkStealingThreadPool> threadPool;
+        std::mutex mutex;
+        std::condition_variable completedCondition;
+        uint32_t pendingTasks = 0;
     };
     using Queue=PromptCPUQueue;
 #endif
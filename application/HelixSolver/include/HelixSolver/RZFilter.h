@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <stdint.h>
+#include <vector>
+
+namespace HelixSolver
+{
+    // Removes spacepoints in excluded r-z regions and rejects events having any of the remaining
+    // spacepoints in event exclusion regions. Points are processed in blocks over SoA columns, r is
+    // computed once per point and regions are tested with branch free loops, so that they are vectorised.
+    class RZFilter
+    {
+    public:
+        // rmin, rmax, zmin, zmax, bounds are not included in the region
+        using Region = std::array<float, 4>;
+
+        RZFilter(const std::vector<Region> &excludedRegions, const std::vector<Region> &eventExclusionRegions);
+
+        // kept points are moved to the front of the columns, returns their count or nullopt when the event is rejected
+        std::optional<uint32_t> filter(uint32_t size, float *xs, float *ys, float *zs) const;
+        // excluded[i] is set for points to remove, returns count of kept points or nullopt when the event is rejected
+        std::optional<uint32_t> classify(uint32_t size, const float *rs, const float *zs, uint8_t *excluded) const;
+
+    private:
+        // region bounds stored per coordinate
+        struct Regions
+        {
+            explicit Regions(const std::vector<Region> &regions);
+
+            std::vector<float> rMins;
+            std::vector<float> rMaxs;
+            std::vector<float> zMins;
+            std::vector<float> zMaxs;
+        };
+
+        // returns true when any kept point of the block rejects the event
+        bool classifyBlock(uint32_t count, const float *rs, const float *zs, uint8_t *excluded) const;
+
+        Regions excludedRegions;
+        Regions eventExclusionRegions;
+    };
+} // namespace HelixSolver
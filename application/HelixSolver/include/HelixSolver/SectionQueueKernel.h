@@ -0,0 +1,73 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/DeviceAtomics.h"
+#include "HelixSolver/LineParametersKernel.h"
+#include "HelixSolver/WedgePoints.h"
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+#else
+#include <vector>
+#endif
+
+namespace HelixSolver
+{
+    // Pointers to the memory of the section queue mode passed to its kernel. Sections are kept in a bounded
+    // multi-producer multi-consumer ring, every slot has a sequence number telling whether it can be written
+    // or read at the given position.
+    struct SectionQueueView
+    {
+        RegionSection *sections;
+        DeviceCounter *sequences;
+        DeviceCounter *counters;
+    };
+
+    // memory of the section queue mode, allocated once per computing worker and reused by its events
+    class SectionQueueStorage
+    {
+    public:
+#ifdef USE_SYCL
+        explicit SectionQueueStorage(sycl::queue &queue);
+#else
+        SectionQueueStorage();
+#endif
+        ~SectionQueueStorage();
+        SectionQueueStorage(const SectionQueueStorage &) = delete;
+        SectionQueueStorage &operator=(const SectionQueueStorage &) = delete;
+
+        const SectionQueueView &getView() const;
+
+    private:
+#ifdef USE_SYCL
+        sycl::queue &queue;
+#else
+        std::vector<RegionSection> sections;
+        std::vector<DeviceCounter> sequences;
+        std::vector<DeviceCounter> counters;
+#endif
+        SectionQueueView view;
+    };
+
+    // Persistent work-items enqueue initial sections of the work regions copied by WedgePointsKernel, then take
+    // sections from the queue until all of them are processed, regardless of the wedge they belong to, and
+    // enqueue their children. When the queue is full sections are processed by the work-item which produced
+    // them, children which do not fit its local stack either are walked right away with StacklessHoughKernel,
+    // so no section is lost. A work-item returns as soon as it finds the queue empty, it never waits for others,
+    // so the kernel makes progress however many of its work-items run at once.
+    class SectionQueueKernel
+    {
+    public:
+        SectionQueueKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, const SectionQueueView &view, uint32_t workItemsCount);
+
+        SYCL_EXTERNAL void operator()(Index1D idx) const;
+
+    private:
+        void processSection(const RegionSection &regionSection) const;
+
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+        SectionQueueView view;
+        uint32_t workItemsCount;
+    };
+} // namespace HelixSolver
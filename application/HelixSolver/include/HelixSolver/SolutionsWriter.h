@@ -0,0 +1,35 @@
+#pragma once
+
+#include <exception>
+#include <string>
+#include <thread>
+
+#include "HelixSolver/ComputingWorker.h"
+#include "ThreadPool/BlockingQueue.h"
+
+namespace HelixSolver
+{
+    // Writes solutions to the solutions TTree of a ROOT file on its own thread, events are released as soon as they are written
+    class SolutionsWriter
+    {
+    public:
+        // path is given without the .root extension
+        SolutionsWriter(const std::string& path, uint32_t queueDepth);
+        SolutionsWriter(const SolutionsWriter&) = delete;
+        ~SolutionsWriter();
+        SolutionsWriter& operator=(const SolutionsWriter&) = delete;
+
+        // blocks when the writer is queueDepth events behind
+        void write(ComputingWorker::EventSoutionsPair&& eventAndSolutions);
+        // writes remaining events and closes the file, rethrows an error of the writer thread
+        void close();
+
+    private:
+        void run();
+
+        const std::string path;
+        ThreadPool::BlockingQueue<ComputingWorker::EventSoutionsPair> eventsAndSolutions;
+        std::exception_ptr writerException;
+        std::thread writer;
+    };
+} // namespace HelixSolver
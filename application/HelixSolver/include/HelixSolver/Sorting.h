@@ -303,7 +303,8 @@ namespace HelixSolver
             std::cout << std::endl;
         }
 
-        static float distanceSectionCenter(AccumulatorSection section, float inverse_r, float phi)
+        // line_a and line_b are accumulator line parameters y = line_a * x + line_b
+        static float distanceSectionCenter(AccumulatorSection section, float line_a, float line_b)
         {
 
             const float x = section.xBegin + 0.5 * section.xSize;
@@ -313,9 +314,9 @@ namespace HelixSolver
             // d = |a*x_1 + b*y_1 + c|/sqrt(a^2 + b^2)
             // phi/(rA) - q/pt - phi/(rA) = 0
 
-            const float a = inverse_r * INVERSE_A;
+            const float a = line_a;
             const float b = -1;
-            const float c = -phi * inverse_r * INVERSE_A;
+            const float c = line_b;
 
             return std::fabs(a * x + b * y + c) / std::sqrt(a * a + b * b);
         }
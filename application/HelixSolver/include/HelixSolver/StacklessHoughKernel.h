@@ -0,0 +1,33 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/WedgePoints.h"
+
+namespace HelixSolver
+{
+    // Variant of DepthFirstHoughKernel walking the sections of its wedge copied by WedgePointsKernel without
+    // the sections stack, launched with the same range. Sections are visited depth-first along the Z-order curve, the next one is computed
+    // from the coordinates of the current one: its first child when it is split, otherwise the next sibling of
+    // the section or of its nearest ancestor having one. Private memory does not depend on the depth of the
+    // tree, so busy wedges cannot overflow it, but lists of crossing lines are not kept either and every
+    // section is tested against all lines of the wedge.
+    class StacklessHoughKernel
+    {
+    public:
+        StacklessHoughKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points);
+
+        SYCL_EXTERNAL void operator()(Index2D idx) const;
+
+        // processes root and all its descendants, root is a section of the wedge of the given initial section
+        // and points, used also by other modes for sections which they have no memory left for
+        void walkSubtree(const CompactSection &root, const AccumulatorSection &initialSection, float *rs_wedge, float *phis_wedge, const float *as_wedge, const float *bs_wedge, uint32_t wedge_spacepoints_count, float wedge_phi_center, float wedge_eta_center) const;
+
+    private:
+        // the section following the given one, which has been processed, returns false when the walk
+        // of the subtree of the section at rootDivisionLevel is over
+        bool nextSection(CompactSection &section, uint8_t rootDivisionLevel) const;
+
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+    };
+} // namespace HelixSolver
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/DeviceAtomics.h"
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+#else
+#include <vector>
+#endif
+
+namespace HelixSolver
+{
+    // section of the accumulator kept in device memory, work region is the index of AdaptiveHoughGpuKernel
+    // work-item the section belongs to, lines crossing the section are not kept
+    struct RegionSection
+    {
+        uint64_t mortonIndex;
+        uint16_t regionPhi;
+        uint16_t regionEta;
+        uint8_t divisionLevel;
+        uint8_t xDepth;
+        uint8_t yDepth;
+
+        static RegionSection fromSection(uint16_t regionPhi, uint16_t regionEta, const CompactSection &section)
+        {
+            return RegionSection{section.mortonIndex, regionPhi, regionEta, section.divisionLevel, section.xDepth, section.yDepth};
+        }
+
+        // the section is tested against all lines of its wedge
+        CompactSection toSection() const
+        {
+            CompactSection section;
+            section.mortonIndex = mortonIndex;
+            section.divisionLevel = divisionLevel;
+            section.xDepth = xDepth;
+            section.yDepth = yDepth;
+            return section;
+        }
+    };
+
+    // Spacepoints of every work region copied next to each other, so that sections of any wedge can be
+    // processed by any work-item. Regions which did not fit have no points, the event must be computed again.
+    struct WedgePointsView
+    {
+        DeviceCounter *top; // points requested by all regions, reset before WedgePointsKernel
+        float *rs;
+        float *phis;
+        float *as;
+        float *bs;
+        uint32_t *candidates; // arenas of the depth-first mode, WEDGE_CANDIDATES_PER_POINT entries per point
+        uint32_t *regionBegins;
+        uint32_t *regionCounts;
+        uint32_t capacity; // of rs, phis, as and bs
+        uint32_t etaRegionsCount;
+        uint32_t regionsCount;
+
+        uint32_t getRegionIndex(uint16_t regionPhi, uint16_t regionEta) const { return regionPhi * etaRegionsCount + regionEta; }
+    };
+
+    // memory of the wedge points, allocated once per computing worker and reused by its events
+    class WedgePointsStorage
+    {
+    public:
+#ifdef USE_SYCL
+        WedgePointsStorage(sycl::queue &queue, uint32_t phiRegionsCount, uint32_t etaRegionsCount);
+#else
+        WedgePointsStorage(uint32_t phiRegionsCount, uint32_t etaRegionsCount);
+#endif
+        ~WedgePointsStorage();
+        WedgePointsStorage(const WedgePointsStorage &) = delete;
+        WedgePointsStorage &operator=(const WedgePointsStorage &) = delete;
+
+        const WedgePointsView &getView() const;
+        // to be called when kernels of the event are completed, returns false when points of all regions fitted,
+        // otherwise the memory is grown to fit them and the event must be computed again
+        bool growToRequestedCapacity();
+
+    private:
+        void allocatePoints(uint32_t capacity);
+
+#ifdef USE_SYCL
+        sycl::queue &queue;
+#else
+        DeviceCounter top;
+        std::vector<float> points;
+        std::vector<uint32_t> candidates;
+        std::vector<uint32_t> regions;
+#endif
+        WedgePointsView view;
+    };
+
+    // A work-item per AdaptiveHoughGpuKernel work-item copies spacepoints of its wedge to the wedge points memory.
+    // Points of all regions are counted in top, regions which do not fit are left without points.
+    class WedgePointsKernel
+    {
+    public:
+        WedgePointsKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points);
+
+        SYCL_EXTERNAL void operator()(Index2D idx) const;
+
+    private:
+        AdaptiveHoughGpuKernel kernel;
+        WedgePointsView points;
+    };
+} // namespace HelixSolver
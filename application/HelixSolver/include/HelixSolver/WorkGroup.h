@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef USE_SYCL
+#include <CL/sycl.hpp>
+#endif
+
+namespace HelixSolver
+{
+    // Collective operations of the work-group running a kernel, all its work-items must call them.
+    // Without SYCL kernels run on threads of the CPU queue, a work-group is a single work-item.
+    class WorkGroup
+    {
+    public:
+#ifdef USE_SYCL
+        explicit WorkGroup(const sycl::nd_item<2> &item)
+            : group(item.get_group()), localId(item.get_local_linear_id()), size(item.get_local_range().size()) {}
+
+        uint32_t exclusiveScan(uint32_t value) const { return sycl::exclusive_scan_over_group(group, value, sycl::plus<uint32_t>()); }
+        uint32_t reduce(uint32_t value) const { return sycl::reduce_over_group(group, value, sycl::plus<uint32_t>()); }
+        // value of the first work-item
+        uint32_t broadcast(uint32_t value) const { return sycl::group_broadcast(group, value); }
+        void barrier() const { sycl::group_barrier(group); }
+#else
+        uint32_t exclusiveScan([[maybe_unused]] uint32_t value) const { return 0; }
+        uint32_t reduce(uint32_t value) const { return value; }
+        uint32_t broadcast(uint32_t value) const { return value; }
+        void barrier() const {}
+#endif
+
+        uint32_t getLocalId() const { return localId; }
+        uint32_t getSize() const { return size; }
+        bool isLeader() const { return localId == 0; }
+
+    private:
+#ifdef USE_SYCL
+        sycl::group<2> group;
+#endif
+        uint32_t localId = 0;
+        uint32_t size = 1;
+    };
+} // namespace HelixSolver
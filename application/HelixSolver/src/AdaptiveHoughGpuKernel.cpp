@@ -10,19 +10,22 @@
 namespace HelixSolver
 {
     AdaptiveHoughGpuKernel::AdaptiveHoughGpuKernel(OptionsAccessor o,
+                                                   uint32_t spacepointsCount,
                                                    FloatBufferReadAccessor rs,
                                                    FloatBufferReadAccessor phis,
                                                    FloatBufferReadAccessor z,
-                                                   SolutionsWriteAccessor solutions)
-        : opts(o), rs(rs), phis(phis), zs(z), solutions(solutions)
+                                                   FloatBufferReadAccessor as,
+                                                   FloatBufferReadAccessor bs,
+                                                   SolutionsWriteAccessor solutions,
+                                                   SolutionsCounterAccessor solutionsCounter)
+        : opts(o), spacepointsCount(spacepointsCount), rs(rs), phis(phis), zs(z), as(as), bs(bs), solutions(solutions), solutionsCounter(solutionsCounter)
     {
         CDEBUG(DISPLAY_BASIC, ".. AdaptiveHoughKernel instantiated with "
-                                  << rs.size() << " measurements ");
+                                  << spacepointsCount << " measurements ");
     }
 
-    void AdaptiveHoughGpuKernel::operator()(Index2D idx) const
+    AdaptiveHoughGpuKernel::WorkRegion AdaptiveHoughGpuKernel::getWorkRegion(Index2D idx) const
     {
-
         HelixSolver::Options opt = opts[0];
         // 'pure" width of wedge which can be used to determine wedge center,
         // obtained by division of the full range of variable by number of regions,
@@ -31,121 +34,112 @@ namespace HelixSolver
         const float wedge_eta_width =
             (ETA_WEDGE_MAX - ETA_WEDGE_MIN) / opt.N_ETA_WEDGE;
 
-        for (uint16_t wedge_index_phi = 0; wedge_index_phi < opt.N_PHI_WEDGE;
-             ++wedge_index_phi)
+        // every work-item processes a single initial division of a single wedge,
+        // first index enumerates phi wedges and divisions along phi within them,
+        // second index enumerates eta wedges and divisions along q/pt
+        const uint16_t wedge_index_phi = idx[0] / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint16_t wedge_index_eta = idx[1] / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint8_t division_x = idx[0] % ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint8_t division_y = idx[1] % ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+
+        const float wedge_phi_center = PHI_BEGIN +
+                                       wedge_phi_width * wedge_index_phi +
+                                       wedge_phi_width / 2.0;
+        const float wedge_eta_center = ETA_WEDGE_MIN + wedge_eta_width / 2.0 +
+                                       wedge_eta_width * wedge_index_eta;
+
+        Reg phi_reg = Reg(wedge_phi_center,
+                          wedge_phi_width / 2.0 + excess_wedge_phi_width);
+        Reg z_reg = Reg(wedge_z_center, wedge_z_width);
+        Reg eta_reg = Reg(wedge_eta_center,
+                          wedge_eta_width / 2.0 + excess_wedge_eta_width);
+
+        float INITIAL_X_SIZE, INITIAL_Y_SIZE;
+        getInitialSectionSize(opt, INITIAL_X_SIZE, INITIAL_Y_SIZE);
+
+        const double xBegin = (phi_reg.center - phi_reg.width) + INITIAL_X_SIZE * division_x;
+        const double yBegin = Q_OVER_PT_BEGIN + INITIAL_Y_SIZE * division_y;
+
+        CDEBUG(DISPLAY_BASIC, " .. AdaptiveHoughKernel region, x: "
+                                  << xBegin << " xsz: " << INITIAL_X_SIZE
+                                  << " y: " << yBegin
+                                  << " ysz: " << INITIAL_Y_SIZE);
+
+        const uint32_t initialDivisionLevel = 0;
+        return WorkRegion{Wedge(phi_reg, z_reg, eta_reg), wedge_phi_center, wedge_eta_center,
+                          AccumulatorSection(INITIAL_X_SIZE, INITIAL_Y_SIZE, xBegin, yBegin, initialDivisionLevel)};
+    }
+
+    void AdaptiveHoughGpuKernel::getInitialSectionSize(const Options &opt, float &xSize, float &ySize)
+    {
+        // the same width as of phi_reg in getWorkRegion
+        const float wedge_phi_width = (PHI_END - PHI_BEGIN) / opt.N_PHI_WEDGE;
+        const float phi_reg_width = wedge_phi_width / 2.0 + excess_wedge_phi_width;
+        xSize = (2 * phi_reg_width) / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        ySize = ACC_Y_SIZE / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+    }
+
+    uint32_t AdaptiveHoughGpuKernel::getDivisionLevelsCount(const Options &opt)
+    {
+        // all sections of a division level have the same size, split as in pushChildren
+        float xSize, ySize;
+        getInitialSectionSize(opt, xSize, ySize);
+        AccumulatorSection section(xSize, ySize, 0, 0, 0);
+        while (section.xSize > opt.ACC_X_PRECISION || section.ySize > opt.ACC_PT_PRECISION)
         {
-            for (uint16_t wedge_index_eta = 0; wedge_index_eta < opt.N_ETA_WEDGE;
-                 ++wedge_index_eta)
-            {
-                // float rs_wedge[MAX_SPACEPOINTS];
-                // float phis_wedge[MAX_SPACEPOINTS];
-                // float zs_wedge[MAX_SPACEPOINTS];
-                // uint32_t wedge_spacepoints_count{};
-
-                // const float wedge_phi_center = PHI_BEGIN +
-                //                                wedge_phi_width * wedge_index_phi +
-                //                                wedge_phi_width / 2.0;
-                // const float wedge_eta_center = ETA_WEDGE_MIN + wedge_eta_width / 2.0 +
-                //                                wedge_eta_width * wedge_index_eta;
-
-                // Reg phi_reg = Reg(wedge_phi_center,
-                //                   wedge_phi_width / 2.0 + excess_wedge_phi_width);
-                // Reg z_reg = Reg(wedge_z_center, wedge_z_width);
-                // Reg eta_reg = Reg(wedge_eta_center,
-                //                   wedge_eta_width / 2.0 + excess_wedge_eta_width);
-
-                // Wedge wedge = Wedge(phi_reg, z_reg, eta_reg);
-
-                // const uint32_t maxIndex = rs.size();
-                // for (uint32_t index = 0; index < maxIndex; ++index)
-                // {
-                //     if (wedge.in_wedge_r_phi_z(rs[index], phis[index], zs[index]))
-                //     {
-                //         rs_wedge[wedge_spacepoints_count] = rs[index];
-                //         phis_wedge[wedge_spacepoints_count] = phis[index];
-                //         zs_wedge[wedge_spacepoints_count] = zs[index];
-
-                //         // take care about phi wrapping around +-PI
-                //         // this is done bye moving the points by 2 PI
-                //         if (wedge.phi_min() < -M_PI &&
-                //             phis_wedge[wedge_spacepoints_count] > wedge.phi_max())
-                //         {
-                //             phis_wedge[wedge_spacepoints_count] -= 2.0 * M_PI;
-                //         }
-
-                //         if (wedge.phi_max() > M_PI &&
-                //             phis_wedge[wedge_spacepoints_count] < wedge.phi_min())
-                //         {
-                //             phis_wedge[wedge_spacepoints_count] += 2.0 * M_PI;
-                //         }
-
-                //         ++wedge_spacepoints_count;
-                //     }
-                // }
-
-                // CDEBUG(DISPLAY_N_WEDGE, wedge_index_phi << "," << wedge_index_eta << ","
-                //                                         << wedge_spacepoints_count
-                //                                         << ":WedgeCounts");
-                // // do not conduct alogorithm calculations for empty region
-                // if (wedge_spacepoints_count == 0)
-                //     continue;
-
-                // CDEBUG(DISPLAY_BASIC, " .. AdaptiveHoughKernel initiated for subregion "
-                //                           << idx[0] << " " << idx[1]);
-
-                // const float INITIAL_X_SIZE = (2 * phi_reg.width) / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
-                // const float INITIAL_Y_SIZE = ACC_Y_SIZE / ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
-
-                // const double xBegin = (phi_reg.center - phi_reg.width) + INITIAL_X_SIZE * idx[0];
-                // const double yBegin = Q_OVER_PT_BEGIN + INITIAL_Y_SIZE * idx[1];
-
-                // CDEBUG(DISPLAY_BASIC, " .. AdaptiveHoughKernel region, x: "
-                //                           << xBegin << " xsz: " << INITIAL_X_SIZE
-                //                           << " y: " << yBegin
-                //                           << " ysz: " << INITIAL_Y_SIZE);
-
-                // we need here a limited set of Points
-
-                // the size os somewhat arbitrary, for regular algorithm dividing into 4
-                // sub-sections it defined by the depth allowed but for more flexible
-                // algorithms that is less predictable for now it is an arbitrary
-                // constant + checks that we stay within this limit
-
-                // AccumulatorSection
-                //     sections[MAX_SECTIONS_BUFFER_SIZE]; // in here sections of image
-                //                                         // will be recorded
-
-                // uint32_t sectionsBufferSize = 1;
-                // const uint32_t initialDivisionLevel = 0;
-                // sections[0] = AccumulatorSection(INITIAL_X_SIZE, INITIAL_Y_SIZE, xBegin,
-                //                                  yBegin, initialDivisionLevel);
-
-                // scan this region until there is no section to process (i.e. size,
-                // initially 1, becomes 0)
-                // while (sectionsBufferSize)
-                // {
-                //     fillAccumulatorSection(sections, sectionsBufferSize, rs_wedge,
-                //                            phis_wedge, zs_wedge, wedge_phi_center, wedge_eta_center,
-                //                            wedge_spacepoints_count);
-                // }
-            }
+            if (section.xSize > opt.ACC_X_PRECISION && section.ySize > opt.ACC_PT_PRECISION)
+                section = section.bottomLeft();
+            else if (section.xSize > opt.ACC_X_PRECISION)
+                section = section.left();
+            else
+                section = section.bottom();
+        }
+        return section.divisionLevel + 1;
+    }
+
+    bool AdaptiveHoughGpuKernel::readWedgeSpacepoint(const Wedge &wedge, uint32_t index, float &r, float &phi, float &a, float &b) const
+    {
+        if (!wedge.in_wedge_r_phi_z(rs[index], phis[index], zs[index]))
+            return false;
+
+        r = rs[index];
+        phi = phis[index];
+        a = as[index];
+        b = bs[index];
+
+        // take care about phi wrapping around +-PI
+        // this is done bye moving the points by 2 PI,
+        // intercept b = -a * phi needs to follow the shift
+        if (wedge.phi_min() < -M_PI && phi > wedge.phi_max())
+        {
+            phi -= 2.0 * M_PI;
+            b += 2.0 * M_PI * a;
+        }
+
+        if (wedge.phi_max() > M_PI && phi < wedge.phi_min())
+        {
+            phi += 2.0 * M_PI;
+            b -= 2.0 * M_PI * a;
         }
+        return true;
     }
 
     void AdaptiveHoughGpuKernel::fillAccumulatorSection(
-        AccumulatorSection *sections, uint32_t &sectionsBufferSize, float *rs_wedge,
-        float *phis_wedge, float *zs_wedge, float wedge_phi_center, float wedge_eta_center,
+        CompactSection *sections, uint32_t &sectionsBufferSize,
+        const AccumulatorSection &initialSection, uint32_t *candidates, uint32_t &candidatesTop, uint32_t candidatesCapacity, float *rs_wedge,
+        float *phis_wedge, float *as_wedge, float *bs_wedge,
+        float wedge_phi_center, float wedge_eta_center,
         uint32_t wedge_spacepoints_count) const
     {
-        HelixSolver::Options opt = opts[0];
-
         CDEBUG(DISPLAY_BASIC,
                "Regions buffer depth " << static_cast<int>(sectionsBufferSize));
         // pop the region from the top of sections buffer
         sectionsBufferSize--;
-        AccumulatorSection section =
-            sections[sectionsBufferSize]; // copy section, it will be modified, TODO
-                                          // consider not to copy
+        const CompactSection compactSection = sections[sectionsBufferSize];
+        AccumulatorSection section = compactSection.toSection(initialSection);
+        // candidates arena is a stack too, lists above the one of this section
+        // belong to subtrees of its siblings which are already processed
+        candidatesTop = section.usesAllCandidates() ? 0 : section.candidatesBegin + section.candidatesCount;
         CDEBUG(DISPLAY_BOX_POSITION, section.xBegin
                                          << "," << section.yBegin << ","
                                          << section.xBegin + section.xSize << ","
@@ -155,14 +149,15 @@ namespace HelixSolver
         // if we are sufficently far in division algorithm, cells can be rejected
         // based also on the condition none of the lines intersects within the cell
         // boundaries, countHits_checkOrder checks that condition
-        uint16_t count = countHits(section, rs_wedge, phis_wedge, zs_wedge, wedge_spacepoints_count);
+        uint32_t crossingCount = 0;
+        uint16_t count = countHits(section, candidates, candidatesTop, candidatesCapacity, crossingCount, as_wedge, bs_wedge, wedge_spacepoints_count);
 
         if (section.divisionLevel >= THRESHOLD_DIVISION_LEVEL_COUNT_HITS_ORDER_CHECK)
         {
             if (count < MAX_COUNT_PER_SECTION)
             {
 
-                count = countHits_checkOrder(section, rs_wedge, phis_wedge, zs_wedge,
+                count = countHits_checkOrder(section, candidates, phis_wedge, as_wedge, bs_wedge,
                                              wedge_spacepoints_count);
             }
         }
@@ -173,10 +168,19 @@ namespace HelixSolver
                    << " y: " << section.yBegin << " ysz: " << section.ySize
                    << " divLevel: " << section.divisionLevel << " count: " << count);
 
-        float threshold = std::fabs(1. / section.xBegin) < opt.THRESHOLD_PT_THRESHOLD ? opt.LOW_PT_THRESHOLD : opt.HIGH_PT_THRESHOLD;
-        if (count < threshold)
+        if (!isAboveThreshold(section, count))
             return;
 
+        // children can only be crossed by lines crossing this section, keep their list
+        // in the arena if it fits, otherwise children inherit the list of this section
+        uint32_t childrenCandidatesBegin = section.candidatesBegin;
+        uint32_t childrenCandidatesCount = section.candidatesCount;
+        if (candidates != nullptr && crossingCount <= candidatesCapacity - candidatesTop)
+        {
+            childrenCandidatesBegin = candidatesTop;
+            childrenCandidatesCount = crossingCount;
+        }
+
         // if (section.xSize < opt.THRESHOLD_X_PRECISION && section.ySize < opt.THRESHOLD_PT_PRECISION && count < opt.THRESHOLD_COUNTER){
 
         //   if (USE_GAUSS_FILTERING) {
@@ -198,6 +202,40 @@ namespace HelixSolver
 
         // } else {
 
+        if (!pushChildren(sections, sectionsBufferSize, compactSection, section, childrenCandidatesBegin, childrenCandidatesCount))
+        { // no more splitting, we have a solution
+            addSolutionIfPeak(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, wedge_phi_center, wedge_eta_center);
+        }
+        //}
+    }
+
+    bool AdaptiveHoughGpuKernel::isAboveThreshold(const AccumulatorSection &section, uint16_t count) const
+    {
+        HelixSolver::Options opt = opts[0];
+        float threshold = std::fabs(1. / section.xBegin) < opt.THRESHOLD_PT_THRESHOLD ? opt.LOW_PT_THRESHOLD : opt.HIGH_PT_THRESHOLD;
+        return count >= threshold;
+    }
+
+    bool AdaptiveHoughGpuKernel::firstChild(const CompactSection &compactSection, const AccumulatorSection &section, CompactSection &child) const
+    {
+        HelixSolver::Options opt = opts[0];
+        const bool splitX = section.xSize > opt.ACC_X_PRECISION;
+        const bool splitY = section.ySize > opt.ACC_PT_PRECISION;
+        if (!splitX && !splitY)
+            return false;
+
+        child = compactSection.child(splitX ? CompactSection::Half::LOWER : CompactSection::Half::WHOLE,
+                                     splitY ? CompactSection::Half::LOWER : CompactSection::Half::WHOLE);
+        return true;
+    }
+
+    bool AdaptiveHoughGpuKernel::pushChildren(CompactSection *sections, uint32_t &sectionsBufferSize,
+                                              const CompactSection &compactSection, const AccumulatorSection &section,
+                                              uint32_t childrenCandidatesBegin,
+                                              uint32_t childrenCandidatesCount) const
+    {
+        HelixSolver::Options opt = opts[0];
+
         if (section.xSize > opt.ACC_X_PRECISION &&
             section.ySize > opt.ACC_PT_PRECISION)
         {
@@ -206,10 +244,15 @@ namespace HelixSolver
             // it may be relevant depending on the data ordering??? to be testes
             ASSURE_THAT(sectionsBufferSize + 3 < MAX_SECTIONS_BUFFER_SIZE,
                         "Sections buffer depth to small (in 4 subregions split)");
-            sections[sectionsBufferSize] = section.bottomLeft();
-            sections[sectionsBufferSize + 1] = section.topLeft();
-            sections[sectionsBufferSize + 2] = section.topRight();
-            sections[sectionsBufferSize + 3] = section.bottomRight();
+            sections[sectionsBufferSize] = compactSection.child(CompactSection::Half::LOWER, CompactSection::Half::LOWER);
+            sections[sectionsBufferSize + 1] = compactSection.child(CompactSection::Half::LOWER, CompactSection::Half::UPPER);
+            sections[sectionsBufferSize + 2] = compactSection.child(CompactSection::Half::UPPER, CompactSection::Half::UPPER);
+            sections[sectionsBufferSize + 3] = compactSection.child(CompactSection::Half::UPPER, CompactSection::Half::LOWER);
+            for (uint32_t child = sectionsBufferSize; child < sectionsBufferSize + 4; ++child)
+            {
+                sections[child].candidatesBegin = childrenCandidatesBegin;
+                sections[child].candidatesCount = childrenCandidatesCount;
+            }
             sectionsBufferSize += 4;
         }
         else if (section.xSize > opt.ACC_X_PRECISION)
@@ -217,8 +260,13 @@ namespace HelixSolver
             CDEBUG(DISPLAY_BASIC, "Splitting region into 2 in x direction");
             ASSURE_THAT(sectionsBufferSize + 1 < MAX_SECTIONS_BUFFER_SIZE,
                         "Sections buffer depth to small (in x split)");
-            sections[sectionsBufferSize] = section.left();
-            sections[sectionsBufferSize + 1] = section.right();
+            sections[sectionsBufferSize] = compactSection.child(CompactSection::Half::LOWER, CompactSection::Half::WHOLE);
+            sections[sectionsBufferSize + 1] = compactSection.child(CompactSection::Half::UPPER, CompactSection::Half::WHOLE);
+            for (uint32_t child = sectionsBufferSize; child < sectionsBufferSize + 2; ++child)
+            {
+                sections[child].candidatesBegin = childrenCandidatesBegin;
+                sections[child].candidatesCount = childrenCandidatesCount;
+            }
             sectionsBufferSize += 2;
         }
         else if (section.ySize > opt.ACC_PT_PRECISION)
@@ -226,56 +274,74 @@ namespace HelixSolver
             CDEBUG(DISPLAY_BASIC, "Splitting region into 2 in y direction");
             ASSURE_THAT(sectionsBufferSize + 1 < MAX_SECTIONS_BUFFER_SIZE,
                         "Sections buffer depth to small (in x split)");
-            sections[sectionsBufferSize] = section.bottom();
-            sections[sectionsBufferSize + 1] = section.top();
+            sections[sectionsBufferSize] = compactSection.child(CompactSection::Half::WHOLE, CompactSection::Half::LOWER);
+            sections[sectionsBufferSize + 1] = compactSection.child(CompactSection::Half::WHOLE, CompactSection::Half::UPPER);
+            for (uint32_t child = sectionsBufferSize; child < sectionsBufferSize + 2; ++child)
+            {
+                sections[child].candidatesBegin = childrenCandidatesBegin;
+                sections[child].candidatesCount = childrenCandidatesCount;
+            }
             sectionsBufferSize += 2;
         }
         else
-        { // no more splitting, we have a solution
+        {
+            return false;
+        }
+        return true;
+    }
 
-            if (USE_GAUSS_FILTERING)
-            {
+    void AdaptiveHoughGpuKernel::addSolutionIfPeak(AccumulatorSection &section, float *rs_wedge, float *phis_wedge,
+                                                   const float *as_wedge, const float *bs_wedge, uint32_t wedge_spacepoints_count,
+                                                   float wedge_phi_center, float wedge_eta_center) const
+    {
+        if (USE_GAUSS_FILTERING)
+        {
 
-                if (isPeakWithinCell(section, rs_wedge, phis_wedge, zs_wedge, wedge_spacepoints_count))
-                {
-                    // if (CrossingsSorter::checkLinearity_R2(section, rs_wedge, phis_wedge, zs_wedge)){
-                    // if (CrossingsSorter::checkLinearity_Simple(section, rs_wedge, phis_wedge, zs_wedge)){
-                    addSolution(section, wedge_phi_center, wedge_eta_center);
-                    //}
-                }
-            }
-            else
+            if (isPeakWithinCell(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count))
             {
+                // if (CrossingsSorter::checkLinearity_R2(section, rs_wedge, phis_wedge, zs_wedge)){
+                // if (CrossingsSorter::checkLinearity_Simple(section, rs_wedge, phis_wedge, zs_wedge)){
                 addSolution(section, wedge_phi_center, wedge_eta_center);
+                //}
             }
         }
-        //}
+        else
+        {
+            addSolution(section, wedge_phi_center, wedge_eta_center);
+        }
     }
 
     uint16_t
-    AdaptiveHoughGpuKernel::countHits(AccumulatorSection &section, float *rs_wedge,
-                                      float *phis_wedge, float *zs_wedge,
+    AdaptiveHoughGpuKernel::countHits(AccumulatorSection &section, uint32_t *candidates,
+                                      uint32_t candidatesTop, uint32_t candidatesCapacity, uint32_t &crossingCount,
+                                      const float *as_wedge, const float *bs_wedge,
                                       uint32_t wedge_spacepoints_count) const
     {
         uint16_t counter = 0;
-        // here we can improve by knowing over which Points to iterate (i.e. indices
-        // of measurements), this is related to geometry this can be stored in section
-        // object maybe???
+        crossingCount = 0;
+        // only lines crossing the parent section need to be checked, all of them are
+        // visited (not only first MAX_COUNT_PER_SECTION) to provide the list for children
+        const uint32_t candidatesCount = section.usesAllCandidates() ? wedge_spacepoints_count : section.candidatesCount;
 
-        for (uint32_t index = 0; index < wedge_spacepoints_count && counter < MAX_COUNT_PER_SECTION;
-             ++index)
+        for (uint32_t candidate = 0; candidate < candidatesCount; ++candidate)
         {
-            const float r = rs_wedge[index];
-            const float inverse_r = 1.0 / r;
-            const float phi = phis_wedge[index];
-            const float a = inverse_r * INVERSE_A;
-            const float b = -inverse_r * INVERSE_A * phi;
+            const uint32_t index = section.usesAllCandidates() ? candidate : candidates[section.candidatesBegin + candidate];
+            const float a = as_wedge[index];
+            const float b = bs_wedge[index];
 
             if (section.isLineInside(a, b))
             {
+                if (candidates != nullptr && candidatesTop + crossingCount < candidatesCapacity)
+                {
+                    candidates[candidatesTop + crossingCount] = index;
+                }
+                ++crossingCount;
 
-                section.indices[counter] = index;
-                counter++;
+                if (counter < MAX_COUNT_PER_SECTION)
+                {
+                    section.indices[counter] = index;
+                    counter++;
+                }
             }
         }
 
@@ -287,19 +353,14 @@ namespace HelixSolver
     }
 
     uint16_t AdaptiveHoughGpuKernel::countHits_checkOrder(
-        AccumulatorSection &section, const float *rs_wedge, const float *phis_wedge,
-        const float *zs_wedge, const uint32_t wedge_spacepoints_count) const
+        AccumulatorSection &section, const uint32_t *candidates, const float *phis_wedge,
+        const float *as_wedge, const float *bs_wedge, const uint32_t wedge_spacepoints_count) const
     {
 
         HelixSolver::Options opt = opts[0];
 
-        const double xEnd = section.xBegin + section.xSize;
-        const double yEnd = section.yBegin + section.ySize;
         uint16_t counter = 0;
 
-        // here we can improve by knowing over which Points to iterate (i.e. indices
-        // of measurements), this is related to geometry this can be stored in section
-        // object maybe???
         uint32_t cell_intersection_acc_id[MAX_COUNT_PER_SECTION];
         float cell_intersection_acc_distance[MAX_COUNT_PER_SECTION];
         uint32_t cell_intersection_cc_id[MAX_COUNT_PER_SECTION];
@@ -308,14 +369,15 @@ namespace HelixSolver
         float mean_phi{};
         float sd_phi{};
 
+        const uint32_t candidatesCount = section.usesAllCandidates() ? wedge_spacepoints_count : section.candidatesCount;
+
         // candidate for parallel_for
-        for (uint32_t index = 0; index < wedge_spacepoints_count && counter < MAX_COUNT_PER_SECTION; ++index)
+        for (uint32_t candidate = 0; candidate < candidatesCount && counter < MAX_COUNT_PER_SECTION; ++candidate)
         {
-            const float r = rs_wedge[index];
-            const float inverse_r = 1.0 / r;
+            const uint32_t index = section.usesAllCandidates() ? candidate : candidates[section.candidatesBegin + candidate];
             const float phi = phis_wedge[index];
-            const float a = inverse_r * INVERSE_A;
-            const float b = -inverse_r * INVERSE_A * phi;
+            const float a = as_wedge[index];
+            const float b = bs_wedge[index];
 
             if (CrossingsSorter::isPhiOnTheRightSide(section, phi) == 0)
                 continue;
@@ -380,7 +442,7 @@ namespace HelixSolver
     }
 
     void AdaptiveHoughGpuKernel::addSolution(const AccumulatorSection &section,
-                                             float wedge_phi_center, float wedge_eta_center) const
+                                             [[maybe_unused]] float wedge_phi_center, float wedge_eta_center) const
     {
         const double qOverPt = section.yBegin + 0.5 * section.ySize;
         const double phi_0 = section.xBegin + 0.5 * section.xSize;
@@ -388,61 +450,67 @@ namespace HelixSolver
         if (fabs(qOverPt) < 1. / MAX_PT)
             return;
 
-        // for truly adaptive algorithm the index can not be calculated in obvious way
-        // therefore the kernel needs to find first available slot to store the
-        // solution for now a stupid solution is to iterate over to the first free
-        // slot this won't be that easy for truly parallel execution, we will likely
-        // need to deffer to sycl::atomic_ref compare_exchange_weak/strong or have the
-        // first pass over to calculate number of solutions
-
         // the coordinates of the solution can be much improved too
         // e.g. using exact formula (i.e. no sin x = x approx), d0 fit & reevaluation,
         // additional hits from pixels inner layers,
         // TODO future work
 
-        const uint32_t solutionsBufferSize = solutions.size();
-        for (uint32_t index = 0; index < solutionsBufferSize; ++index)
+        // solutions are appended at the atomically incremented counter so that
+        // concurrent work-items never write the same slot
+#ifdef USE_SYCL
+        sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device, sycl::access::address_space::global_space>
+            solutionsCount(solutionsCounter[SOLUTIONS_COUNT_INDEX]);
+        const uint32_t index = solutionsCount.fetch_add(1);
+#else
+        const uint32_t index = solutionsCounter[SOLUTIONS_COUNT_INDEX].fetch_add(1, std::memory_order_relaxed);
+#endif
+        if (index >= solutions.size())
         {
-            if (solutions[index].phi == SolutionCircle::INVALID_PHI)
-            {
-                if (section.canUseIndices())
-                {
-                    fillPreciseSolution(section, solutions[index]);
-                    CDEBUG(DISPLAY_BASIC,
-                           "AdaptiveHoughKernel solution count: " << int(section.counts));
-                } // but for now it is always the simple one
-                solutions[index].pt = std::fabs(1. / qOverPt);
-                solutions[index].phi = phi_0;
-                // temporary solution - eta of a particle is equal to ea of the region
-                solutions[index].eta = wedge_eta_center;
-                solutions[index].nhits = section.counts;
-                solutions[index].q = qOverPt < 0 ? -1. : 1.;
-
-                CDEBUG(DISPLAY_BASIC, "AdaptiveHoughKernel solution q/pt:"
-                                          << qOverPt << " phi: " << phi_0);
-                CDEBUG(DISPLAY_SOLUTION_PAIR,
-                       qOverPt << "," << phi_0 << "," << wedge_phi_center << "," << wedge_eta_center
-                               << "," << section.xBegin << ","
-                               << section.yBegin << "," << section.xBegin + section.xSize
-                               << "," << section.yBegin + section.ySize << ","
-                               << section.divisionLevel << ":SolutionPair");
-                // TODO calculate remaining parameters, eta, z, d0
-                return;
-            }
+#ifdef USE_SYCL
+            sycl::atomic_ref<uint32_t, sycl::memory_order::relaxed, sycl::memory_scope::device, sycl::access::address_space::global_space>
+                solutionsOverflow(solutionsCounter[SOLUTIONS_OVERFLOW_INDEX]);
+            solutionsOverflow.store(1);
+#else
+            solutionsCounter[SOLUTIONS_OVERFLOW_INDEX].store(1, std::memory_order_relaxed);
+#endif
+            return;
         }
-        ASSURE_THAT(false, "Could not find place for solution!!");
+
+        if (section.canUseIndices())
+        {
+            fillPreciseSolution(section, solutions[index]);
+            CDEBUG(DISPLAY_BASIC,
+                   "AdaptiveHoughKernel solution count: " << int(section.counts));
+        } // but for now it is always the simple one
+        solutions[index].pt = std::fabs(1. / qOverPt);
+        solutions[index].phi = phi_0;
+        // temporary solution - eta of a particle is equal to ea of the region
+        solutions[index].eta = wedge_eta_center;
+        solutions[index].nhits = section.counts;
+        solutions[index].q = qOverPt < 0 ? -1. : 1.;
+
+        CDEBUG(DISPLAY_BASIC, "AdaptiveHoughKernel solution q/pt:"
+                                  << qOverPt << " phi: " << phi_0);
+        CDEBUG(DISPLAY_SOLUTION_PAIR,
+               qOverPt << "," << phi_0 << "," << wedge_phi_center << "," << wedge_eta_center
+                       << "," << section.xBegin << ","
+                       << section.yBegin << "," << section.xBegin + section.xSize
+                       << "," << section.yBegin + section.ySize << ","
+                       << section.divisionLevel << ":SolutionPair");
+        // TODO calculate remaining parameters, eta, z, d0
     }
 
     void AdaptiveHoughGpuKernel::fillPreciseSolution(
-        const AccumulatorSection &section, SolutionCircle &s) const
+        [[maybe_unused]] const AccumulatorSection &section, [[maybe_unused]] SolutionCircle &s) const
     {
         // TODO complete it
     }
 
     bool AdaptiveHoughGpuKernel::isPeakWithinCell(
         AccumulatorSection &section, float *rs_wedge,
-        float *phis_wedge, float *zs_wedge,
-        uint32_t wedge_spacepoints_count) const
+        float *phis_wedge,
+        const float *as_wedge, const float *bs_wedge,
+        [[maybe_unused]] uint32_t wedge_spacepoints_count) const
     {
 
         HelixSolver::Options opt = opts[0];
@@ -511,8 +579,8 @@ namespace HelixSolver
                     if (Wedge::phi_dist(phi_main, phi_secondary) > max_delta_phi)
                     {
 
-                        float dist1 = CrossingsSorter::distanceSectionCenter(section, 1. / r_main, phi_main);
-                        float dist2 = CrossingsSorter::distanceSectionCenter(section, 1. / r_secondary, phi_secondary);
+                        float dist1 = CrossingsSorter::distanceSectionCenter(section, as_wedge[section.indices[index_main]], bs_wedge[section.indices[index_main]]);
+                        float dist2 = CrossingsSorter::distanceSectionCenter(section, as_wedge[section.indices[index_secondary]], bs_wedge[section.indices[index_secondary]]);
 
                         if (dist1 < dist2)
                         {
@@ -0,0 +1,226 @@
+#ifndef USE_SYCL
+#include <iostream>
+#endif
+
+#include "Debug/Debug.h"
+#include "HelixSolver/AdaptiveHoughGroupKernel.h"
+#include "HelixSolver/Sorting.h"
+
+namespace HelixSolver
+{
+#ifdef USE_SYCL
+    AdaptiveHoughGroupKernel::AdaptiveHoughGroupKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, sycl::handler &handler)
+        : kernel(kernel)
+        , points(points)
+        , candidates(sycl::range<1>(GROUP_CANDIDATES_ARENA_SIZE), handler)
+        , tileIndices(sycl::range<1>(GROUP_TILE_SIZE), handler)
+        , tilePhis(sycl::range<1>(GROUP_TILE_SIZE), handler)
+        , tileAs(sycl::range<1>(GROUP_TILE_SIZE), handler)
+        , tileBs(sycl::range<1>(GROUP_TILE_SIZE), handler)
+        , sectionLines(sycl::range<1>(MAX_COUNT_PER_SECTION), handler)
+        , peaks(sycl::range<1>(GROUP_PEAKS_BATCH_SIZE), handler)
+    {
+    }
+#else
+    AdaptiveHoughGroupKernel::AdaptiveHoughGroupKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points)
+        : kernel(kernel), points(points)
+    {
+    }
+#endif
+
+    void AdaptiveHoughGroupKernel::operator()(GroupItem2D item) const
+    {
+#ifdef USE_SYCL
+        const WorkGroup group(item);
+        const Index2D idx(item.get_group(0), item.get_group(1));
+        const GroupMemory memory{&candidates[0], &tileIndices[0], &tilePhis[0], &tileAs[0], &tileBs[0], &sectionLines[0], &peaks[0]};
+#else
+        const WorkGroup group;
+        const Index2D idx = item;
+        uint32_t candidatesArena[GROUP_CANDIDATES_ARENA_SIZE];
+        uint32_t indicesTile[GROUP_TILE_SIZE];
+        float phisTile[GROUP_TILE_SIZE];
+        float asTile[GROUP_TILE_SIZE];
+        float bsTile[GROUP_TILE_SIZE];
+        uint32_t lines[MAX_COUNT_PER_SECTION];
+        AccumulatorSection peaksBatch[GROUP_PEAKS_BATCH_SIZE];
+        const GroupMemory memory{candidatesArena, indicesTile, phisTile, asTile, bsTile, lines, peaksBatch};
+#endif
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(idx);
+        const uint32_t regionIndex = points.getRegionIndex(idx[0], idx[1]);
+        const uint32_t wedge_spacepoints_count = points.regionCounts[regionIndex];
+
+        CDEBUG(DISPLAY_N_WEDGE, idx[0] << "," << idx[1] << "," << wedge_spacepoints_count << ":WedgeCounts");
+        if (wedge_spacepoints_count == 0)
+            return;
+
+        float *rs_wedge = points.rs + points.regionBegins[regionIndex];
+        float *phis_wedge = points.phis + points.regionBegins[regionIndex];
+        const float *as_wedge = points.as + points.regionBegins[regionIndex];
+        const float *bs_wedge = points.bs + points.regionBegins[regionIndex];
+
+        // every work-item keeps its own copy of the stack, they are the same as all of them take the same decisions
+        CompactSection sections[MAX_SECTIONS_BUFFER_SIZE];
+        uint32_t sectionsBufferSize = 1;
+        sections[0] = CompactSection();
+        uint32_t candidatesTop = 0;
+        uint32_t peaksCount = 0;
+
+        while (sectionsBufferSize)
+        {
+            sectionsBufferSize--;
+            const CompactSection compactSection = sections[sectionsBufferSize];
+            AccumulatorSection section = compactSection.toSection(region.initialSection);
+            candidatesTop = section.usesAllCandidates() ? 0 : section.candidatesBegin + section.candidatesCount;
+
+            uint32_t crossingCount = 0;
+            uint16_t count = countHits(group, memory, section, candidatesTop, crossingCount, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+
+            if (section.divisionLevel >= THRESHOLD_DIVISION_LEVEL_COUNT_HITS_ORDER_CHECK && count < MAX_COUNT_PER_SECTION)
+                count = countHits_checkOrder(group, memory, section, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+
+            if (!kernel.isAboveThreshold(section, count))
+                continue;
+
+            uint32_t childrenCandidatesBegin = section.candidatesBegin;
+            uint32_t childrenCandidatesCount = section.candidatesCount;
+            if (crossingCount <= GROUP_CANDIDATES_ARENA_SIZE - candidatesTop)
+            {
+                childrenCandidatesBegin = candidatesTop;
+                childrenCandidatesCount = crossingCount;
+            }
+
+            if (!kernel.pushChildren(sections, sectionsBufferSize, compactSection, section, childrenCandidatesBegin, childrenCandidatesCount))
+            {
+                // lines of the section are known to the first work-item only (see countHits_checkOrder)
+                if (group.isLeader())
+                    memory.peaks[peaksCount] = section;
+                if (++peaksCount == GROUP_PEAKS_BATCH_SIZE)
+                {
+                    checkPeaks(group, memory, peaksCount, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, region.wedgePhiCenter, region.wedgeEtaCenter);
+                    peaksCount = 0;
+                }
+            }
+        }
+        checkPeaks(group, memory, peaksCount, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, region.wedgePhiCenter, region.wedgeEtaCenter);
+    }
+
+    void AdaptiveHoughGroupKernel::stageTile(const WorkGroup &group, const GroupMemory &memory, const AccumulatorSection &section,
+                                             uint32_t tileBegin, uint32_t tileSize,
+                                             const float *phis_wedge, const float *as_wedge, const float *bs_wedge) const
+    {
+        // the tile is read by all work-items, the previous one must not be in use any more
+        group.barrier();
+        for (uint32_t line = group.getLocalId(); line < tileSize; line += group.getSize())
+        {
+            const uint32_t candidate = tileBegin + line;
+            const uint32_t index = section.usesAllCandidates() ? candidate : memory.candidates[section.candidatesBegin + candidate];
+            memory.tileIndices[line] = index;
+            memory.tilePhis[line] = phis_wedge[index];
+            memory.tileAs[line] = as_wedge[index];
+            memory.tileBs[line] = bs_wedge[index];
+        }
+        group.barrier();
+    }
+
+    uint16_t AdaptiveHoughGroupKernel::countHits(const WorkGroup &group, const GroupMemory &memory, AccumulatorSection &section,
+                                                 uint32_t candidatesTop, uint32_t &crossingCount,
+                                                 const float *phis_wedge, const float *as_wedge, const float *bs_wedge,
+                                                 uint32_t wedge_spacepoints_count) const
+    {
+        crossingCount = 0;
+        const uint32_t candidatesCount = section.usesAllCandidates() ? wedge_spacepoints_count : section.candidatesCount;
+
+        for (uint32_t tileBegin = 0; tileBegin < candidatesCount; tileBegin += GROUP_TILE_SIZE)
+        {
+            const uint32_t tileSize = candidatesCount - tileBegin < GROUP_TILE_SIZE ? candidatesCount - tileBegin : GROUP_TILE_SIZE;
+            stageTile(group, memory, section, tileBegin, tileSize, phis_wedge, as_wedge, bs_wedge);
+
+            // crossing lines keep the order of candidates, first MAX_COUNT_PER_SECTION of them are the section indices
+            for (uint32_t roundBegin = 0; roundBegin < tileSize; roundBegin += group.getSize())
+            {
+                const uint32_t line = roundBegin + group.getLocalId();
+                const bool inside = line < tileSize && section.isLineInside(memory.tileAs[line], memory.tileBs[line]);
+                const uint32_t position = crossingCount + group.exclusiveScan(inside ? 1 : 0);
+                if (inside)
+                {
+                    if (candidatesTop + position < GROUP_CANDIDATES_ARENA_SIZE)
+                        memory.candidates[candidatesTop + position] = memory.tileIndices[line];
+                    if (position < MAX_COUNT_PER_SECTION)
+                        memory.sectionLines[position] = memory.tileIndices[line];
+                }
+                crossingCount += group.reduce(inside ? 1 : 0);
+            }
+        }
+        group.barrier();
+
+        const uint16_t counter = crossingCount < MAX_COUNT_PER_SECTION ? crossingCount : MAX_COUNT_PER_SECTION;
+        for (uint16_t index = 0; index < counter; ++index)
+            section.indices[index] = memory.sectionLines[index];
+        section.counts =
+            (counter + 1) == MAX_COUNT_PER_SECTION
+                ? section.OUT_OF_RANGE_COUNTS
+                : counter; // setting this counter to 0 == indices are invalid
+        return counter;
+    }
+
+    uint16_t AdaptiveHoughGroupKernel::countHits_checkOrder(const WorkGroup &group, const GroupMemory &memory, AccumulatorSection &section,
+                                                            const float *phis_wedge, const float *as_wedge, const float *bs_wedge,
+                                                            uint32_t wedge_spacepoints_count) const
+    {
+        // AdaptiveHoughGpuKernel::countHits_checkOrder takes the first MAX_COUNT_PER_SECTION lines on the right side
+        // and crossing the section, they are found by the group and passed to it as the only candidates
+        uint32_t linesCount = 0;
+        const uint32_t candidatesCount = section.usesAllCandidates() ? wedge_spacepoints_count : section.candidatesCount;
+        for (uint32_t tileBegin = 0; tileBegin < candidatesCount && linesCount < MAX_COUNT_PER_SECTION; tileBegin += GROUP_TILE_SIZE)
+        {
+            const uint32_t tileSize = candidatesCount - tileBegin < GROUP_TILE_SIZE ? candidatesCount - tileBegin : GROUP_TILE_SIZE;
+            stageTile(group, memory, section, tileBegin, tileSize, phis_wedge, as_wedge, bs_wedge);
+
+            for (uint32_t roundBegin = 0; roundBegin < tileSize && linesCount < MAX_COUNT_PER_SECTION; roundBegin += group.getSize())
+            {
+                const uint32_t line = roundBegin + group.getLocalId();
+                const bool taken = line < tileSize && CrossingsSorter::isPhiOnTheRightSide(section, memory.tilePhis[line]) &&
+                                   section.isLineInside(memory.tileAs[line], memory.tileBs[line]);
+                const uint32_t position = linesCount + group.exclusiveScan(taken ? 1 : 0);
+                if (taken && position < MAX_COUNT_PER_SECTION)
+                    memory.sectionLines[position] = memory.tileIndices[line];
+                linesCount += group.reduce(taken ? 1 : 0);
+            }
+        }
+        group.barrier();
+
+        uint16_t count = 0;
+        if (group.isLeader())
+        {
+            AccumulatorSection lines = section;
+            lines.candidatesBegin = 0;
+            lines.candidatesCount = linesCount < MAX_COUNT_PER_SECTION ? linesCount : MAX_COUNT_PER_SECTION;
+            count = kernel.countHits_checkOrder(lines, memory.sectionLines, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+            for (uint16_t index = 0; index < MAX_COUNT_PER_SECTION; ++index)
+                section.indices[index] = lines.indices[index];
+            section.counts = lines.counts;
+        }
+        count = group.broadcast(count);
+        // sectionLines are written again for the next section
+        group.barrier();
+        return count;
+    }
+
+    void AdaptiveHoughGroupKernel::checkPeaks(const WorkGroup &group, const GroupMemory &memory, uint32_t peaksCount,
+                                              float *rs_wedge, float *phis_wedge, const float *as_wedge, const float *bs_wedge,
+                                              uint32_t wedge_spacepoints_count, float wedge_phi_center, float wedge_eta_center) const
+    {
+        if (peaksCount == 0)
+            return;
+
+        group.barrier();
+        for (uint32_t peak = group.getLocalId(); peak < peaksCount; peak += group.getSize())
+        {
+            AccumulatorSection section = memory.peaks[peak];
+            kernel.addSolutionIfPeak(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, wedge_phi_center, wedge_eta_center);
+        }
+        // peaks are collected again by the first work-item
+        group.barrier();
+    }
+} // namespace HelixSolver
@@ -1,12 +1,27 @@
 #include <iostream>
 #include <fstream>
 #include <TFile.h>
+#include <TROOT.h>
 #include <TTree.h>
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <thread>
 
 #include "HelixSolver/Application.h"
 #include "HelixSolver/ComputingManager.h"
+#include "HelixSolver/SolutionsWriter.h"
+#include "SharedMemoryRing/Ring.h"
+#include "SharedMemoryRing/Slots.h"
+#include "SpacepointsFile/CsvReader.h"
+#include "SpacepointsFile/EntryIndex.h"
+#include "SpacepointsFile/MappedReader.h"
+#include "ThreadPool/WorkStealingThreadPool.h"
 #include "Debug/Debug.h"
 #include "HelixSolver/Constants.h"
 
@@ -23,6 +38,8 @@ namespace HelixSolver
         }
 
         loadConfig(argv[1]);
+        // input is read and output is written on separate threads
+        ROOT::EnableThreadSafety();
     }
 
     void Application::run()
@@ -46,81 +63,141 @@ namespace HelixSolver
 
     void Application::runOnCpu() const
     {
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> events = loadEvents(config["inputFile"]);
+        ComputingManager computingManager(getPlatformFromString(config["platform"]), config["cpuEventBuffers"], config["cpuComputingWorkers"]);
 
-#ifdef MULTIPLY_EVENTS
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> newEvents = std::make_unique<std::vector<std::shared_ptr<Event>>>();
+        processEvents(computingManager);
+    }
 
-        for (unsigned int i = 0; i < config["multiplyEvents"]; i++)
-        {
-            for (auto event : *events)
-            {
-                newEvents->push_back(std::shared_ptr<Event>(new Event(*event)));
-            }
-        }
+    void Application::runOnGpu() const
+    {
+        ComputingManager computingManager(ComputingWorker::Platform::GPU, config["gpuEventBuffers"], config["gpuComputingWorkers"]);
 
-        events.swap(newEvents);
-#endif
+        processEvents(computingManager);
+    }
 
-        ComputingManager computingManager(getPlatformFromString(config["platform"]), config["cpuEventBuffers"], config["cpuComputingWorkers"]);
+    void Application::processEvents(ComputingManager &computingManager) const
+    {
+        if (config.value("runAsService", false))
+            serveEvents(computingManager);
+        else
+            computeEvents(computingManager);
+    }
+
+    void Application::computeEvents(ComputingManager &computingManager) const
+    {
+        // memory taken by events read ahead of computation and by solutions waiting for output is bounded by the queues depth
+        EventsQueue events(config.value("inputEventsQueueDepth", DEFAULT_INPUT_EVENTS_QUEUE_DEPTH));
+        std::exception_ptr producerException;
+        SolutionsWriter solutionsWriter(config["outputFile"].get<std::string>(), config.value("outputEventsQueueDepth", DEFAULT_OUTPUT_EVENTS_QUEUE_DEPTH));
+        computingManager.setSolutionsConsumer([&solutionsWriter](ComputingWorker::EventSoutionsPair &&eventAndSolutions)
+        {
+            solutionsWriter.write(std::move(eventAndSolutions));
+        });
+        uint32_t eventsCount = 0;
 
         auto executionTimeStart = std::chrono::high_resolution_clock::now();
 
-        for (std::shared_ptr<Event> &event : *events)
+        std::thread producer([this, &events, &producerException]()
         {
-            while (!computingManager.addEvent(event))
+            try
             {
-                computingManager.waitForWaitingWorker();
-                computingManager.update();
+                loadEvents(config["inputFile"], events);
+            }
+            catch (...)
+            {
+                producerException = std::current_exception();
+                events.close();
+            }
+        });
+
+        try
+        {
+            while (std::optional<std::shared_ptr<Event>> event = events.pop())
+            {
+                while (!computingManager.addEvent(*event))
+                    computingManager.waitForAnyCompletion();
+                ++eventsCount;
             }
         }
+        catch (...)
+        {
+            // the producer may be blocked on the full queue, closing it makes the producer stop
+            events.close();
+            producer.join();
+            throw;
+        }
+        producer.join();
+        if (producerException)
+            std::rethrow_exception(producerException);
+
         computingManager.waitUntillAllTasksCompleted();
-        std::unique_ptr<std::vector<std::pair<std::shared_ptr<Event>, std::unique_ptr<std::vector<SolutionCircle>>>>> eventsAndSolutions = computingManager.transferSolutions();
+        solutionsWriter.close();
 
         auto executionTimeEnd = std::chrono::high_resolution_clock::now();
         auto elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(executionTimeEnd - executionTimeStart).count();
         auto elapsedTime_sec = round(float(elapsedTime) / 1e3) / 1e3;
-        INFO("Computing " << events->size() << " events took " << elapsedTime_sec << " seconds");
-
-        saveSolutionsInRootFile(eventsAndSolutions, config["outputFile"].get<std::string>());
+        INFO("Reading, computing and writing " << eventsCount << " events took " << elapsedTime_sec << " seconds");
     }
 
-    void Application::runOnGpu() const
+    void Application::serveEvents(ComputingManager &computingManager) const
     {
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> events = loadEvents(config["inputFile"]);
-
-#ifdef MULTIPLY_EVENTS
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> newEvents = std::make_unique<std::vector<std::shared_ptr<Event>>>();
-        auto x = config["multiplyEvents"];
-        for (unsigned int i = 0; i < config["multiplyEvents"]; i++)
+        // rings are created here and removed when the service stops, clients attach to them
+        const std::string eventsRingName = config.value("serviceEventsRing", std::string(DEFAULT_SERVICE_EVENTS_RING));
+        const std::string resultsRingName = config.value("serviceResultsRing", std::string(DEFAULT_SERVICE_RESULTS_RING));
+        const uint32_t ringSlots = config.value("serviceRingSlots", DEFAULT_SERVICE_RING_SLOTS);
+        SharedMemoryRing::Ring eventsRing(eventsRingName, ringSlots, SharedMemoryRing::EventSlotLayout::getSlotSize(MAX_SPACEPOINTS));
+        SharedMemoryRing::Ring resultsRing(resultsRingName, ringSlots, SharedMemoryRing::ResultSlotLayout::getSlotSize(config.value("serviceMaxSolutions", DEFAULT_SERVICE_MAX_SOLUTIONS)));
+        const SharedMemoryRing::EventSlotLayout eventsLayout(eventsRing.getSlotSize());
+        const SharedMemoryRing::ResultSlotLayout resultsLayout(resultsRing.getSlotSize());
+        INFO("Serving events from " << eventsRingName << ", solutions are written to " << resultsRingName);
+
+        static_assert(sizeof(SharedMemoryRing::Solution) == sizeof(SolutionCircle), "Solutions are passed to clients field by field");
+        computingManager.setSolutionsConsumer([&resultsRing, &resultsLayout](ComputingWorker::EventSoutionsPair &&eventAndSolutions)
         {
-            for (auto event : *events)
+            // blocks while the client does not read results
+            std::byte *slot = resultsRing.acquireWriteSlot();
+            const std::vector<SolutionCircle> &solutions = *eventAndSolutions.second;
+            const uint32_t solutionsCount = std::min<uint32_t>(solutions.size(), resultsLayout.maxSolutions);
+            *reinterpret_cast<SharedMemoryRing::ResultSlotHeader *>(slot) = SharedMemoryRing::ResultSlotHeader{eventAndSolutions.first->getId(), solutionsCount, solutions.size() > solutionsCount};
+            SharedMemoryRing::Solution *slotSolutions = reinterpret_cast<SharedMemoryRing::Solution *>(slot + resultsLayout.solutionsOffset);
+            for (uint32_t i = 0; i < solutionsCount; ++i)
             {
-                newEvents->push_back(std::shared_ptr<Event>(new Event(*event)));
+                const SolutionCircle &solution = solutions[i];
+                slotSolutions[i] = SharedMemoryRing::Solution{solution.pt, solution.phi, solution.eta, solution.z, solution.d0, solution.nhits, solution.q};
             }
-        }
-
-        events.swap(newEvents);
-#endif
+            resultsRing.commitWriteSlot();
+        });
+        uint32_t eventsCount = 0;
 
-        ComputingManager computingManager(ComputingWorker::Platform::GPU, config["gpuEventBuffers"], config["gpuComputingWorkers"]);
+        while (!eventsRing.isDrained())
+        {
+            const std::byte *slot = eventsRing.tryAcquireReadSlot();
+            if (slot == nullptr)
+            {
+                // solutions of completed events are passed to the client while waiting for the next event
+                computingManager.update();
+                std::this_thread::sleep_for(std::chrono::microseconds(SERVICE_POLL_INTERVAL_US));
+                continue;
+            }
 
-        auto executionTimeStart = std::chrono::high_resolution_clock::now();
+            // slots are reused by the client, so columns are copied to the event
+            const SharedMemoryRing::EventSlotHeader &header = *reinterpret_cast<const SharedMemoryRing::EventSlotHeader *>(slot);
+            const uint32_t pointsCount = std::min(header.pointsCount, eventsLayout.maxPoints);
+            std::shared_ptr<Event> event = std::make_shared<Event>(Event::fromPolar(header.eventId, pointsCount,
+                reinterpret_cast<const float *>(slot + eventsLayout.rsOffset),
+                reinterpret_cast<const float *>(slot + eventsLayout.phisOffset),
+                reinterpret_cast<const float *>(slot + eventsLayout.zsOffset),
+                reinterpret_cast<const uint8_t *>(slot + eventsLayout.layersOffset)));
+            eventsRing.releaseReadSlot();
 
-        for (std::shared_ptr<Event> &event : *events)
-        {
             while (!computingManager.addEvent(event))
-                computingManager.update();
+                computingManager.waitForAnyCompletion();
+            ++eventsCount;
         }
-        computingManager.waitUntillAllTasksCompleted();
-        std::unique_ptr<std::vector<std::pair<std::shared_ptr<Event>, std::unique_ptr<std::vector<SolutionCircle>>>>> eventsAndSolutions = computingManager.transferSolutions();
 
-        auto executionTimeEnd = std::chrono::high_resolution_clock::now();
-        auto elapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(executionTimeEnd - executionTimeStart).count();
-        auto elapsedTime_sec = round(float(elapsedTime) / 1e3) / 1e3;
-        INFO("Computing " << events->size() << " events took " << elapsedTime_sec << " seconds");
-
-        saveSolutionsInRootFile(eventsAndSolutions, config["outputFile"].get<std::string>());
+        computingManager.waitUntillAllTasksCompleted();
+        resultsRing.close();
+        INFO("Served " << eventsCount << " events");
     }
 
     ComputingWorker::Platform Application::getPlatformFromString(const std::string &platformStr)
@@ -139,175 +216,452 @@ namespace HelixSolver
         return ComputingWorker::Platform::BAD_PLATFORM;
     }
 
-    std::unique_ptr<std::vector<std::shared_ptr<Event>>> Application::loadEvents(const std::string &path) const
+    void Application::loadEvents(const std::string &path, EventsQueue &events) const
     {
         if (config["inputFileType"] == "root_spacepoints")
-            return loadEventsFromSpacepointsRootFile(path);
-        else
+            loadEventsFromSpacepointsRootFile(path, events);
+        else if (config["inputFileType"] == "binary_spacepoints")
+            loadEventsFromSpacepointsBinaryFile(path, events);
+        else if (config["inputFileType"] == "csv_spacepoints")
+            loadEventsFromSpacepointsCsvDirectory(path, events);
+        // * Reading other file types are not implemented yet.
+        events.close();
+    }
+
+    bool Application::pushEvent(std::shared_ptr<Event> event, EventsQueue &events) const
+    {
+#ifdef MULTIPLY_EVENTS
+        for (unsigned int i = 1; i < config["multiplyEvents"]; i++)
+        {
+            // replicas view the columns of the event, nothing is copied, their ids are distinct so that solutions can be told apart
+            if (!events.push(std::make_shared<Event>(event->replicate(event->getId() + i * REPLICATED_EVENTS_ID_STRIDE))))
+                return false;
+        }
+#endif
+        return events.push(std::move(event));
+    }
+
+    bool Application::SpacepointsSelection::selectsAll() const
+    {
+        return not eventIds && not eventsRange;
+    }
+
+    bool Application::SpacepointsSelection::selects(Event::EventId eventId) const
+    {
+        if (eventsRange)
+            return eventsRange->first <= eventId && eventId <= eventsRange->second;
+        return not eventIds || std::binary_search(eventIds->begin(), eventIds->end(), eventId);
+    }
+
+    Application::SpacepointsSelection Application::spacepointsSelection() const
+    {
+        SpacepointsSelection selection{std::nullopt, std::nullopt, rzFilter()};
+        // to analyse only some events add "event", "events" (list of ids) or "eventsRange" ([first, last]) property in config file
+        if (config.contains("event"))
+        {
+            selection.eventIds = std::vector<Event::EventId>{config["event"].get<Event::EventId>()};
+        }
+        else if (config.contains("events"))
+        {
+            selection.eventIds = config["events"].get<std::vector<Event::EventId>>();
+        }
+        else if (config.contains("eventsRange"))
+        {
+            // only the bounds are kept, the range can be as large as all ids
+            const std::vector<Event::EventId> range = config["eventsRange"].get<std::vector<Event::EventId>>();
+            if (range.size() != 2 || range[0] > range[1])
+                throw std::invalid_argument("eventsRange must be [first, last] with first <= last");
+            selection.eventsRange = std::make_pair(range[0], range[1]);
+        }
+        if (selection.eventIds)
+            std::sort(selection.eventIds->begin(), selection.eventIds->end());
+        return selection;
+    }
+
+    RZFilter Application::rzFilter() const
+    {
+        return RZFilter(rzRegions("excludeRZRegions"), rzRegions("excludeEventsWithHitsInRZ"));
+    }
+
+    std::vector<RZFilter::Region> Application::rzRegions(const std::string &settingName) const
+    {
+        std::vector<RZFilter::Region> regions;
+        if (!config.contains(settingName))
         {
-            // * Reading other file types are not implemented yet.
-            return std::unique_ptr<std::vector<std::shared_ptr<Event>>>();
+            DEBUG("No regions in " << settingName);
+            return regions;
         }
+        DEBUG("Nontrivial regions " << config[settingName]);
+        for (auto conf : config[settingName])
+        {
+            regions.push_back(RZFilter::Region{conf[0], conf[1], conf[2], conf[3]});
+            DEBUG("Region: rmin: " << conf[0] << " rmax: " << conf[1] << " zmin: " << conf[2] << " zmax: " << conf[3]);
+        }
+        return regions;
     }
 
-    std::function<bool(float, float, float)> Application::selector(const std::string &settingName, bool defaultDecision) const
+    void Application::loadEventsFromSpacepointsRootFile(const std::string &path, EventsQueue &events) const
     {
-        // defaultDecisionine selector, default one selects all points
-        if (config.contains(settingName))
+        const uint32_t readerThreads = std::max(1u, config.value("inputReaderThreads", std::thread::hardware_concurrency()));
+        // config is not accessed from reader threads
+        const SpacepointsSelection selection = spacepointsSelection();
+        std::vector<std::pair<int64_t, int64_t>> entryRanges;
+        {
+            std::unique_ptr<TFile> file(TFile::Open(path.c_str()));
+            if (file == nullptr)
+            {
+                throw std::runtime_error("Can't open input file: " + path);
+            }
+            INFO("... Opened: " << path);
+            const std::string treeName = "spacepoints";
+            std::unique_ptr<TTree> hitsTree(file->Get<TTree>(treeName.c_str()));
+            if (hitsTree == nullptr)
+            {
+                throw std::runtime_error("Can't access tree in the ROOT file: " + treeName);
+            }
+            INFO("... Accessed input tree: " << treeName << " in " << path);
+
+            if (!selection.selectsAll())
+                entryRanges = findEntryRanges(path, *hitsTree, selection);
+            else
+                entryRanges = splitIntoEntryRanges(*hitsTree, readerThreads);
+        }
+        INFO("... Reading " << entryRanges.size() << " entry ranges with " << readerThreads << " threads");
+
+        // ranges are read concurrently but consumed in order, at most readerThreads of them are in memory
+        std::deque<std::future<std::vector<EventPoints>>> rangesInFlight;
+        uint32_t nextRange = 0;
+        auto readNextRange = [&]()
+        {
+            const std::pair<int64_t, int64_t> entryRange = entryRanges[nextRange++];
+            rangesInFlight.push_back(std::async(std::launch::async, [&path, entryRange, &selection]()
+            {
+                return readSpacepointsRootEntries(path, entryRange.first, entryRange.second, selection);
+            }));
+        };
+
+        std::optional<EventPoints> currentEvent;
+        std::set<Event::EventId> completedEventIds;
+        auto completeEvent = [&]() -> bool
         {
-            DEBUG("Nontrivial selector " << config[settingName]);
-            struct region
+            if (!currentEvent)
+                return true;
+            if (!completedEventIds.insert(currentEvent->eventId).second)
             {
-                float rmin, rmax, zmin, zmax;
-            };
-            std::vector<region> exclusionRegions;
-            for (auto conf : config[settingName])
+                INFO("Entries of event " << currentEvent->eventId << " are not consecutive in the input, they are processed as separate events");
+            }
+            EventPoints eventPoints = std::move(*currentEvent);
+            currentEvent.reset();
+            // clean events from those having hits in undesired region
+            if (!eventPoints.takeIt)
             {
-                exclusionRegions.emplace_back(region{conf[0], conf[1], conf[2], conf[3]});
-                DEBUG("Will skip points from region: rmin: "
-                      << exclusionRegions.back().rmin
-                      << " rmax: " << exclusionRegions.back().rmax
-                      << " zmin: " << exclusionRegions.back().zmin
-                      << " zmax: " << exclusionRegions.back().zmax);
+                // DEBUG("Skipped event because it has hits in exclusion region");
+                return true;
             }
-            return [exclusionRegions](float x, float y, float z)
+            CDEBUG(DISPLAY_OK_EVENTS, eventPoints.eventId << ":Events");
+            return pushEvent(std::make_shared<Event>(Event::fromCartesian(eventPoints.eventId, eventPoints.xs.size(),
+                                                                         eventPoints.xs.data(), eventPoints.ys.data(), eventPoints.zs.data())), events);
+        };
+
+        while (nextRange < entryRanges.size() && rangesInFlight.size() < readerThreads)
+            readNextRange();
+        while (!rangesInFlight.empty())
+        {
+            std::vector<EventPoints> rangeEvents = rangesInFlight.front().get();
+            rangesInFlight.pop_front();
+            if (nextRange < entryRanges.size())
+                readNextRange();
+
+            for (EventPoints &eventPoints : rangeEvents)
             {
-                float r = std::hypot(x, y);
-                // check if the point belongs to any region
-                for (auto region : exclusionRegions)
+                // an event can be split between consecutive ranges
+                if (currentEvent && currentEvent->eventId == eventPoints.eventId)
                 {
-                    if (region.rmin < r && r < region.rmax && region.zmin < z && z < region.zmax)
-                        return true;
+                    currentEvent->xs.insert(currentEvent->xs.end(), eventPoints.xs.begin(), eventPoints.xs.end());
+                    currentEvent->ys.insert(currentEvent->ys.end(), eventPoints.ys.begin(), eventPoints.ys.end());
+                    currentEvent->zs.insert(currentEvent->zs.end(), eventPoints.zs.begin(), eventPoints.zs.end());
+                    currentEvent->takeIt = currentEvent->takeIt && eventPoints.takeIt;
+                    continue;
                 }
-                return false;
-            };
+                if (!completeEvent())
+                    return;
+                currentEvent = std::move(eventPoints);
+            }
+        }
+        completeEvent();
+        INFO("... Input data loaded");
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> Application::splitIntoEntryRanges(TTree &hitsTree, uint32_t readerThreads)
+    {
+        // ranges follow cluster boundaries, so that baskets are not decompressed by two readers
+        const int64_t entries = hitsTree.GetEntries();
+        const int64_t minRangeSize = entries / (readerThreads * INPUT_ENTRY_RANGES_PER_THREAD) + 1;
+
+        std::vector<std::pair<int64_t, int64_t>> entryRanges;
+        TTree::TClusterIterator clusterIterator = hitsTree.GetClusterIterator(0);
+        int64_t rangeBegin = 0;
+        Long64_t clusterBegin;
+        while ((clusterBegin = clusterIterator()) < entries)
+        {
+            const int64_t clusterEnd = std::min<int64_t>(clusterIterator.GetNextEntry(), entries);
+            if (clusterEnd - rangeBegin >= minRangeSize || clusterEnd == entries)
+            {
+                entryRanges.emplace_back(rangeBegin, clusterEnd);
+                rangeBegin = clusterEnd;
+            }
+        }
+        return entryRanges;
+    }
+
+    std::vector<std::pair<int64_t, int64_t>> Application::findEntryRanges(const std::string &path, TTree &hitsTree, const SpacepointsSelection &selection)
+    {
+        const std::string indexPath = SpacepointsFile::EntryIndex::getSidecarPath(path);
+        std::optional<SpacepointsFile::EntryIndex> index = SpacepointsFile::EntryIndex::load(indexPath, path);
+        if (!index)
+        {
+            // only event ids are read to build the index
+            INFO("... Building index of events: " << indexPath);
+            index.emplace();
+            uint32_t eventId;
+            hitsTree.SetBranchStatus("*", false);
+            hitsTree.SetBranchStatus("event_id", true);
+            hitsTree.SetBranchAddress("event_id", &eventId);
+            const int64_t entries = hitsTree.GetEntries();
+            for (int64_t i = 0; i < entries; i++)
+            {
+                hitsTree.GetEntry(i);
+                index->addEntry(eventId, i);
+            }
+            hitsTree.ResetBranchAddresses();
+
+            try
+            {
+                index->save(indexPath, path);
+            }
+            catch (const std::exception &e)
+            {
+                INFO("... Index not saved, it will be built again on next run: " << e.what());
+            }
         }
-        DEBUG("Selecting all points");
-        return [defaultDecision](float x, float y, float z)
-        { return defaultDecision; };
+        if (selection.eventsRange)
+            return index->findEntriesInRange(selection.eventsRange->first, selection.eventsRange->second);
+        return index->findEntries(*selection.eventIds);
     }
 
-    std::unique_ptr<std::vector<std::shared_ptr<Event>>> Application::loadEventsFromSpacepointsRootFile(const std::string &path) const
+    std::vector<Application::EventPoints> Application::readSpacepointsRootEntries(const std::string &path, int64_t begin, int64_t end, const SpacepointsSelection &selection)
     {
+        // ROOT objects are not shared between threads, each range is read through its own file and tree
         std::unique_ptr<TFile> file(TFile::Open(path.c_str()));
         if (file == nullptr)
         {
             throw std::runtime_error("Can't open input file: " + path);
         }
-        INFO("... Opened: " << path);
         const std::string treeName = "spacepoints";
         std::unique_ptr<TTree> hitsTree(file->Get<TTree>(treeName.c_str()));
         if (hitsTree == nullptr)
         {
             throw std::runtime_error("Can't access tree in the ROOT file: " + treeName);
         }
-        INFO("... Accessed input tree: " << treeName << " in " << path);
 
         uint32_t eventId;
         float x;
         float y;
         float z;
-        uint8_t layer = 0;
 
+        hitsTree->SetBranchStatus("*", false);
+        for (const char *branch : {"event_id", "x", "y", "z"})
+            hitsTree->SetBranchStatus(branch, true);
         hitsTree->SetBranchAddress("event_id", &eventId);
         hitsTree->SetBranchAddress("x", &x);
         hitsTree->SetBranchAddress("y", &y);
         hitsTree->SetBranchAddress("z", &z);
 
-        std::map<Event::EventId, std::unique_ptr<std::vector<Point>>> points;
-        auto inExcludedRZRegions = selector("excludeRZRegions");
+        hitsTree->SetCacheSize(INPUT_TREE_CACHE_SIZE);
+        hitsTree->SetCacheEntryRange(begin, end);
+        hitsTree->AddBranchToCache("*", true);
+        hitsTree->StopCacheLearningPhase();
 
-        for (int i = 0; hitsTree->LoadTree(i) >= 0; i++)
+        std::vector<EventPoints> rangeEvents;
+        // points of the last event past this count are not filtered yet, they are filtered in blocks
+        // so that the event can be rejected before all its entries are read
+        uint32_t filteredPoints = 0;
+        auto filterPendingPoints = [&]()
         {
-            hitsTree->GetEntry(i);
-
-            if (not config.contains("event") ||
-                (config.contains("event") && eventId == config["event"]))
-            { // to analyse only a single event add "event" property in config file
-                points.try_emplace(eventId, std::make_unique<std::vector<Point>>());
-                if (not inExcludedRZRegions(x, y, z))
-                {
-                    points[eventId]->push_back(Point{x, y, z, layer});
-                    CDEBUG(DISPLAY_RPHI, std::hypot(x, y) << "," << std::atan2(y, x) << "," << z << ":RPhi");
-                    // DEBUG("Accepted point, r: " << std::hypot(x,y) << ", z: " << z);
-                } // else DEBUG("Rejected point, r: " << std::hypot(x,y) << ", z: " << z);
+            EventPoints &eventPoints = rangeEvents.back();
+            const uint32_t pendingPoints = eventPoints.xs.size() - filteredPoints;
+            std::optional<uint32_t> keptPoints = selection.rzFilter.filter(pendingPoints, eventPoints.xs.data() + filteredPoints,
+                                                                           eventPoints.ys.data() + filteredPoints, eventPoints.zs.data() + filteredPoints);
+            if (!keptPoints)
+            {
+                // DEBUG("Point in exclusion region, will skip the event");
+                eventPoints.takeIt = false;
+                keptPoints = 0;
+                filteredPoints = 0;
             }
-        }
-        // clean events from those having hits in undesired region
-        auto excludeEventsWithHitsInRZ = selector("excludeEventsWithHitsInRZ");
-        std::unique_ptr<std::vector<std::shared_ptr<Event>>> events = std::make_unique<std::vector<std::shared_ptr<Event>>>();
-        for (auto &idAndPoints : points)
+            for (uint32_t j = filteredPoints; j < filteredPoints + *keptPoints; ++j)
+            {
+                CDEBUG(DISPLAY_RPHI, std::hypot(eventPoints.xs[j], eventPoints.ys[j]) << "," << std::atan2(eventPoints.ys[j], eventPoints.xs[j]) << "," << eventPoints.zs[j] << ":RPhi");
+            }
+            filteredPoints += *keptPoints;
+            eventPoints.xs.resize(filteredPoints);
+            eventPoints.ys.resize(filteredPoints);
+            eventPoints.zs.resize(filteredPoints);
+        };
+
+        for (int64_t i = begin; i < end; i++)
         {
-            bool takeIt = true;
-            for (auto data : *idAndPoints.second)
+            hitsTree->GetEntry(i);
+
+            if (selection.selects(eventId))
             {
-                if (excludeEventsWithHitsInRZ(data.x, data.y, data.z))
+                if (rangeEvents.empty() || eventId != rangeEvents.back().eventId)
                 {
-                    // DEBUG("Point in exclusion region, r:" <<  std::hypot(data.x, data.y) << " z:" << data.z << " will skip the event");
-                    takeIt = false;
-                    break;
+                    if (!rangeEvents.empty())
+                        filterPendingPoints();
+                    rangeEvents.push_back(EventPoints{eventId, {}, {}, {}, true});
+                    filteredPoints = 0;
                 }
+                EventPoints &eventPoints = rangeEvents.back();
+                if (!eventPoints.takeIt)
+                    continue;
+                eventPoints.xs.push_back(x);
+                eventPoints.ys.push_back(y);
+                eventPoints.zs.push_back(z);
+                if (eventPoints.xs.size() - filteredPoints == RZ_FILTER_BLOCK_SIZE)
+                    filterPendingPoints();
             }
-            if (takeIt)
+        }
+        if (!rangeEvents.empty())
+            filterPendingPoints();
+        return rangeEvents;
+    }
+
+    void Application::loadEventsFromSpacepointsBinaryFile(const std::string &path, EventsQueue &events) const
+    {
+        // events keep the mapping alive as long as any of them is in use
+        std::shared_ptr<const SpacepointsFile::MappedReader> reader = std::make_shared<const SpacepointsFile::MappedReader>(path);
+        INFO("... Mapped: " << path << " with " << reader->getEventsCount() << " events");
+
+        const SpacepointsSelection selection = spacepointsSelection();
+
+        // columns of events with excluded points are gathered here before being copied to the event
+        std::vector<uint8_t> excluded;
+        std::vector<float> rs, phis, zs;
+        std::vector<uint8_t> layers;
+        for (uint32_t i = 0; i < reader->getEventsCount(); ++i)
+        {
+            const SpacepointsFile::EventView view = reader->getEvent(i);
+            if (!selection.selects(view.eventId))
+                continue;
+
+            excluded.resize(view.pointsCount);
+            const std::optional<uint32_t> keptPoints = selection.rzFilter.classify(view.pointsCount, view.rs, view.zs, excluded.data());
+            if (!keptPoints)
+                continue;
+            CDEBUG(DISPLAY_OK_EVENTS, view.eventId << ":Events");
+
+            std::shared_ptr<Event> event;
+            if (*keptPoints == view.pointsCount)
             {
-                events->push_back(std::make_shared<Event>(idAndPoints.first, std::move(idAndPoints.second)));
-                // DEBUG("Will use event");
-                CDEBUG(DISPLAY_OK_EVENTS, idAndPoints.first << ":Events");
+                event = std::make_shared<Event>(view.eventId, view.pointsCount, view.rs, view.phis, view.zs, view.layers, reader);
             }
             else
             {
-                // DEBUG("Skipped event because it has hits in exclusion region");
+                // only events with points in excluded regions are copied
+                rs.clear();
+                phis.clear();
+                zs.clear();
+                layers.clear();
+                for (uint32_t j = 0; j < view.pointsCount; ++j)
+                {
+                    if (excluded[j])
+                        continue;
+                    rs.push_back(view.rs[j]);
+                    phis.push_back(view.phis[j]);
+                    zs.push_back(view.zs[j]);
+                    layers.push_back(view.layers[j]);
+                }
+                event = std::make_shared<Event>(Event::fromPolar(view.eventId, rs.size(), rs.data(), phis.data(), zs.data(), layers.data()));
             }
+
+            if (!pushEvent(std::move(event), events))
+                return;
         }
         INFO("... Input data loaded");
-        return events;
     }
 
-    void Application::saveSolutionsInRootFile(const std::unique_ptr<std::vector<ComputingWorker::EventSoutionsPair>> &eventsAndSolutions, const std::string &path)
+    void Application::loadEventsFromSpacepointsCsvDirectory(const std::string &path, EventsQueue &events) const
     {
-        TFile *f = TFile::Open((path + ".root").c_str(), "RECREATE"); // we overwrite output, maybe this is wrong idea? TODO, decide
-        uint32_t eventId{};
-        float phi{};
-        float pt{};
-        float q{};
-        float eta{};
-        float z{};
-        float d0{};
-        int nhits{};
-
-        TTree *outputTree = new TTree("solutions", "solutions");
-        outputTree->Branch("event_id", &eventId);
-        outputTree->Branch("phi", &phi);
-        outputTree->Branch("pt", &pt);
-        outputTree->Branch("eta", &eta);
-        outputTree->Branch("q", &q);
-        outputTree->Branch("z", &z);
-        outputTree->Branch("d0", &d0);
-        outputTree->Branch("nhits", &nhits);
-
-        for (const auto &eventAndSolution : *eventsAndSolutions)
-        {
-            eventId = eventAndSolution.first->getId();
+        const uint32_t readerThreads = std::max(1u, config.value("inputReaderThreads", std::thread::hardware_concurrency()));
+        // config is not accessed from reader threads
+        const SpacepointsSelection selection = spacepointsSelection();
 
-            for (const SolutionCircle &solution : *eventAndSolution.second)
+        const std::string suffix = "-spacepoint.csv";
+        std::vector<std::pair<Event::EventId, std::string>> files;
+        for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(path))
+        {
+            const std::string fileName = entry.path().filename().string();
+            if (!entry.is_regular_file() || fileName.size() < suffix.size()
+                || fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) != 0)
+                continue;
+            std::optional<uint32_t> eventId = SpacepointsFile::CsvReader::eventIdFromFileName(fileName);
+            if (eventId && selection.selects(*eventId))
+                files.emplace_back(*eventId, entry.path().string());
+        }
+        std::sort(files.begin(), files.end());
+        INFO("... Found " << files.size() << " spacepoint files in " << path << ", reading with " << readerThreads << " threads");
+
+        // files are parsed concurrently but events are pushed in order of their ids, at most readerThreads of them are in memory,
+        // reader threads live until the end of input so that scratch columns of readSpacepointsCsvFile are reused by their files
+        ThreadPool::WorkStealingThreadPool readers(readerThreads);
+        std::deque<std::future<std::shared_ptr<Event>>> filesInFlight;
+        uint32_t nextFile = 0;
+        auto readNextFile = [&]()
+        {
+            const std::pair<Event::EventId, std::string> &file = files[nextFile++];
+            // exceptions of the reader are passed to the future, pool tasks must not throw
+            auto read = std::make_shared<std::packaged_task<std::shared_ptr<Event>()>>([&file, &selection]()
             {
-                if (solution.invalid())
-                    break;
-
-                phi = solution.phi;
-                pt = solution.pt;
-                q = solution.q;
-                eta = solution.eta;
-                z = solution.z;
-                d0 = solution.d0;
-                nhits = solution.nhits;
-
-                outputTree->Fill();
-            }
+                return readSpacepointsCsvFile(file.second, file.first, selection);
+            });
+            filesInFlight.push_back(read->get_future());
+            readers.submit([read]() { (*read)(); });
+        };
+
+        while (nextFile < files.size() && filesInFlight.size() < readerThreads)
+            readNextFile();
+        while (!filesInFlight.empty())
+        {
+            std::shared_ptr<Event> event = filesInFlight.front().get();
+            filesInFlight.pop_front();
+            if (nextFile < files.size())
+                readNextFile();
+
+            // clean events from those having hits in undesired region
+            if (event == nullptr)
+                continue;
+            CDEBUG(DISPLAY_OK_EVENTS, event->getId() << ":Events");
+            if (!pushEvent(std::move(event), events))
+                return;
         }
-        DEBUG("Output data saved to file " + path + ".root");
-        f->Write();
-        f->Close();
+        INFO("... Input data loaded");
+    }
+
+    std::shared_ptr<Event> Application::readSpacepointsCsvFile(const std::string &path, Event::EventId eventId, const SpacepointsSelection &selection)
+    {
+        // cartesian columns are only needed until conversion, their memory is reused by following files of the reader thread
+        thread_local std::vector<float> xs;
+        thread_local std::vector<float> ys;
+        thread_local std::vector<float> csvZs;
+        SpacepointsFile::CsvReader::read(path, xs, ys, csvZs);
+
+        // kept points are compacted in place and converted to polar coordinates at once
+        const std::optional<uint32_t> keptPoints = selection.rzFilter.filter(xs.size(), xs.data(), ys.data(), csvZs.data());
+        if (!keptPoints)
+            return nullptr;
+
+        return std::make_shared<Event>(Event::fromCartesian(eventId, *keptPoints, xs.data(), ys.data(), csvZs.data()));
     }
 
     void Application::loadConfig(const std::string &configFilePath)
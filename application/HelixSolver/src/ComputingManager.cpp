@@ -1,3 +1,4 @@
+#include <iostream>
 #include <stdexcept>
 #include <string>
 
@@ -6,6 +7,7 @@
 #endif
 
 #include "HelixSolver/ComputingManager.h"
+#include "HelixSolver/Constants.h"
 #include "Debug/Debug.h"
 
 namespace HelixSolver
@@ -13,15 +15,21 @@ namespace HelixSolver
     ComputingManager::ComputingManager(ComputingWorker::Platform platform, uint32_t numBuffers, uint32_t numWorkers)
     : platform(platform)
     {
+#ifndef USE_SYCL
+        threadPool = std::make_shared<ThreadPool::WorkStealingThreadPool>();
+        INFO( "CPU threads: " << threadPool->getThreadsCount() );
+#endif
+
         for(uint32_t i = 0; i < numBuffers; i++)
         {
             eventBuffers.push_back(std::make_shared<EventBuffer>());
-            freeEventBuffers.push(i);
+            freeEventBuffers.push_back(i);
         }
 
         for(uint32_t i = 0; i < numWorkers; i++)
         {
             computingWorkers.push_back(std::make_shared<ComputingWorker>(getNewQueue()));
+            computingWorkers.back()->setCompletionCallback([this](){ notifyCompletion(); });
             waitingComputingWorkers.push(i);
         }
         #ifdef USE_SYCL
@@ -35,41 +43,86 @@ namespace HelixSolver
         #endif
     }
 
+    ComputingManager::~ComputingManager()
+    {
+        // completion callbacks of still running workers refer to the condition variable
+        for(std::shared_ptr<ComputingWorker> &computingWorker : computingWorkers)
+        {
+            computingWorker->waitUntillCompleted();
+        }
+    }
+
     bool ComputingManager::addEvent(std::shared_ptr<Event> event)
     {
         if(freeEventBuffers.empty()) return false;
 
-        std::shared_ptr<EventBuffer> eventBuffer = eventBuffers[freeEventBuffers.front()];
+        uint32_t eventSize = event->getSize();
+        if(eventSize >= spacepointsCapacity)
+        {
+            spacepointsCapacity = (eventSize / SPACEPOINTS_CAPACITY_GRANULARITY + 1) * SPACEPOINTS_CAPACITY_GRANULARITY;
+        }
+
+        std::deque<uint32_t>::iterator freeEventBuffer = selectFreeEventBuffer(*event);
+        std::shared_ptr<EventBuffer> eventBuffer = eventBuffers[*freeEventBuffer];
+        eventBuffer->reserve(spacepointsCapacity);
         eventBuffer->loadEvent(std::move(event));
         eventBuffer->setState(EventBuffer::EventBufferState::READY);
-        readyEventBuffers.push(freeEventBuffers.front());
-        freeEventBuffers.pop();
+        readyEventBuffers.push(*freeEventBuffer);
+        freeEventBuffers.erase(freeEventBuffer);
 
         update();
 
         return true;
     }
 
+    std::deque<uint32_t>::iterator ComputingManager::selectFreeEventBuffer(const Event &event)
+    {
+        for(std::deque<uint32_t>::iterator buffer = freeEventBuffers.begin(); buffer != freeEventBuffers.end(); ++buffer)
+        {
+            if(eventBuffers[*buffer]->holdsColumnsOf(event)) return buffer;
+        }
+        return freeEventBuffers.begin();
+    }
+
     void ComputingManager::waitUntillAllTasksCompleted()
     {
-        while(!(readyEventBuffers.empty() && processedEventBuffers.empty() && processingComputingWorkers.empty()))
+        update();
+        while(!(readyEventBuffers.empty() && processingComputingWorkers.empty()))
         {
-            while(!processingComputingWorkers.empty())
-            {
-                computingWorkers[processingComputingWorkers.front()]->waitUntillCompleted();
-                update();
-            }
-            update();
+            waitForAnyCompletion();
         }
     }
 
-    void ComputingManager::waitForWaitingWorker()
+    void ComputingManager::waitForAnyCompletion()
     {
+        update();
         if(processingComputingWorkers.empty()) return;
 
-        computingWorkers[processingComputingWorkers.front()]->waitUntillCompleted();
+        {
+            std::unique_lock<std::mutex> lock(completionMutex);
+            completionCondition.wait(lock, [this](){ return anyProcessingWorkerCompleted(); });
+        }
+        update();
     }
 
+    bool ComputingManager::anyProcessingWorkerCompleted() const
+    {
+        for(uint32_t worker : processingComputingWorkers)
+        {
+            if(computingWorkers[worker]->isCompleted()) return true;
+        }
+        return false;
+    }
+
+    void ComputingManager::notifyCompletion()
+    {
+        // called from the worker completion thread, locking orders it with the predicate check
+        // in waitForAnyCompletion so that the notification can not be lost
+        {
+            std::lock_guard<std::mutex> lock(completionMutex);
+        }
+        completionCondition.notify_all();
+    }
 
     std::unique_ptr<std::vector<ComputingWorker::EventSoutionsPair>> ComputingManager::transferSolutions()
     {
@@ -78,6 +131,11 @@ namespace HelixSolver
         return std::move(solutions);
     }
 
+    void ComputingManager::setSolutionsConsumer(std::function<void(ComputingWorker::EventSoutionsPair&&)> consumer)
+    {
+        solutionsConsumer = std::move(consumer);
+    }
+
     void ComputingManager::update()
     {
         startProcessingReadyBuffers();
@@ -115,11 +173,12 @@ namespace HelixSolver
             }
 
             std::pair<std::shared_ptr<Event>, std::unique_ptr<std::vector<SolutionCircle>>> newSolutions = computingWorkers[worker]->transferSolutions();
-            solutions->push_back(std::move(newSolutions));
+            if(solutionsConsumer) solutionsConsumer(std::move(newSolutions));
+            else solutions->push_back(std::move(newSolutions));
 
             waitingComputingWorkers.push(worker);
             computingWorkers[worker]->setState(ComputingWorker::ComputingWorkerState::WAITING);
-            freeEventBuffers.push(buffer);
+            freeEventBuffers.push_back(buffer);
             eventBuffers[buffer]->setState(EventBuffer::EventBufferState::FREE);
         }
 
@@ -148,7 +207,7 @@ namespace HelixSolver
         switch (platform)
         {
             case ComputingWorker::Platform::CPU_NO_SYCL:
-                return std::make_unique<Queue>();
+                return std::make_unique<Queue>(threadPool);
             default:
                 throw std::runtime_error("Bad platform: " + std::to_string(static_cast<int>(platform))+ " in " + __FILE__ + ":" + std::to_string(__LINE__));
         }
@@ -1,14 +1,79 @@
+#include <algorithm>
+#include <iostream>
+#ifndef USE_SYCL
+#include <thread>
+#endif
 #include <nlohmann/json.hpp>
 #include "HelixSolver/ComputingWorker.h"
 #include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/AdaptiveHoughGroupKernel.h"
+#include "HelixSolver/DepthFirstHoughKernel.h"
+#include "HelixSolver/LineParametersKernel.h"
+#include "HelixSolver/SectionQueueKernel.h"
+#include "HelixSolver/StacklessHoughKernel.h"
 #include "HelixSolver/Options.h"
 #include "HelixSolver/Constants.h"
 extern nlohmann::json config;
-#define USE_SYCL
 namespace HelixSolver
 {
     ComputingWorker::ComputingWorker(std::unique_ptr<Queue> &&queue)
-        : queue(std::move(queue)) {}
+        : queue(std::move(queue))
+    {
+        options.ACC_X_PRECISION = config["phi_precision"];
+        options.ACC_PT_PRECISION = config["pt_precision"];
+
+        options.N_PHI_WEDGE = config["n_phi_regions"];
+        options.N_ETA_WEDGE = config["n_eta_regions"];
+
+        options.THRESHOLD_PT_THRESHOLD = config["threshold_pt_threshold"];
+        options.LOW_PT_THRESHOLD = config["low_pt_threshold"];
+        options.HIGH_PT_THRESHOLD = config["high_pt_threshold"];
+
+        options.N_SIGMA_GAUSS = config["n_sigma_gauss"];
+        options.STDEV_CORRECTION = config["stdev_correction"];
+        options.MIN_LINES_GAUSS = config["min_lines_gauss"];
+
+        options.THRESHOLD_X_PRECISION = config["threshold_x_precision"];
+        options.THRESHOLD_PT_PRECISION = config["threshold_pt_precision"];
+        options.THRESHOLD_COUNTER = config["threshold_counter"];
+
+        adaptiveKernelMode = getAdaptiveKernelModeFromString(config.value("adaptiveKernelMode", std::string("depthFirst")));
+
+        // buffers below live as long as the worker and are reused by all events it processes
+        const std::vector<HelixSolver::Options> opt(1, options);
+        optionsBuffer = std::make_unique<OptionsBuffer>(opt.begin(), opt.end());
+#ifdef USE_SYCL
+        // kernel writes only the prefix of solutions buffer reported by the counter, no need to initialise it
+        solutionsBuffer = std::make_unique<SolutionBuffer>(sycl::range<1>(MAX_SOLUTIONS));
+        solutionsCounterBuffer = std::make_unique<SolutionsCounterBuffer>(sycl::range<1>(SOLUTIONS_COUNTER_SIZE));
+#else
+        solutionsBuffer = std::make_unique<SolutionBuffer>(MAX_SOLUTIONS);
+        solutionsCounterBuffer = std::make_unique<SolutionsCounterBuffer>(SOLUTIONS_COUNTER_SIZE);
+#endif
+        const uint32_t phiRegionsCount = options.N_PHI_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint32_t etaRegionsCount = options.N_ETA_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        frontierLevelsCount = AdaptiveHoughGpuKernel::getDivisionLevelsCount(options);
+        ASSURE_THAT((phiRegionsCount * etaRegionsCount <= FRONTIER_CAPACITY), "Work regions do not fit the initial frontier");
+#ifdef USE_SYCL
+        wedgePointsStorage = std::make_unique<WedgePointsStorage>(*this->queue, phiRegionsCount, etaRegionsCount);
+        if (adaptiveKernelMode == AdaptiveKernelMode::SECTION_QUEUE)
+            sectionQueueStorage = std::make_unique<SectionQueueStorage>(*this->queue);
+        if (adaptiveKernelMode == AdaptiveKernelMode::FRONTIER)
+            frontierStorage = std::make_unique<FrontierStorage>(*this->queue, frontierLevelsCount);
+#else
+        wedgePointsStorage = std::make_unique<WedgePointsStorage>(phiRegionsCount, etaRegionsCount);
+        if (adaptiveKernelMode == AdaptiveKernelMode::SECTION_QUEUE)
+            sectionQueueStorage = std::make_unique<SectionQueueStorage>();
+        if (adaptiveKernelMode == AdaptiveKernelMode::FRONTIER)
+            frontierStorage = std::make_unique<FrontierStorage>(frontierLevelsCount);
+#endif
+    }
+
+    ComputingWorker::~ComputingWorker()
+    {
+        // completion host task refers to this worker, it must not outlive it
+        queue->wait();
+    }
 
     ComputingWorker::ComputingWorkerState ComputingWorker::updateAndGetState()
     {
@@ -38,19 +103,68 @@ namespace HelixSolver
         return queue.get();
     }
 
+    void ComputingWorker::setCompletionCallback(std::function<void()> callback)
+    {
+        completionCallback = std::move(callback);
+    }
+
+    bool ComputingWorker::isCompleted() const
+    {
+        return completed.load(std::memory_order_acquire);
+    }
+
+    void ComputingWorker::markCompleted()
+    {
+        completed.store(true, std::memory_order_release);
+        if (completionCallback)
+            completionCallback();
+    }
+
+    ComputingWorker::AdaptiveKernelMode ComputingWorker::getAdaptiveKernelModeFromString(const std::string &modeStr)
+    {
+        if (modeStr == "workGroup")
+            return AdaptiveKernelMode::WORK_GROUP;
+        if (modeStr == "sectionQueue")
+            return AdaptiveKernelMode::SECTION_QUEUE;
+        if (modeStr == "frontier")
+            return AdaptiveKernelMode::FRONTIER;
+        if (modeStr == "stackless")
+            return AdaptiveKernelMode::STACKLESS;
+        if (modeStr != "depthFirst")
+            INFO("Unknown adaptiveKernelMode " << modeStr << ", using depthFirst");
+
+        return AdaptiveKernelMode::DEPTH_FIRST;
+    }
+
     ComputingWorker::EventSoutionsPair ComputingWorker::transferSolutions()
     {
         if (state != ComputingWorkerState::COMPLETED)
             return std::make_pair(std::shared_ptr<Event>(), std::unique_ptr<std::vector<SolutionCircle>>());
         state = ComputingWorkerState::WAITING;
 #ifdef USE_SYCL
-        // TODO: Move to scheduleTasksToQueue
-        sycl::host_accessor solutionsAccessor(*solutionsBuffer, sycl::read_only);
-        for (uint32_t i = 0; i < solutionsAccessor.size(); ++i)
-            (*solutions)[i] = solutionsAccessor[i];
+        // only the counter is read first, then the valid prefix of solutions buffer is copied
+        sycl::host_accessor solutionsCounterAccessor(*solutionsCounterBuffer, sycl::read_only);
+        const uint32_t solutionsCount = std::min(solutionsCounterAccessor[SOLUTIONS_COUNT_INDEX], MAX_SOLUTIONS);
+        const bool solutionsOverflow = solutionsCounterAccessor[SOLUTIONS_OVERFLOW_INDEX] != 0;
+
+        solutions = std::make_unique<std::vector<SolutionCircle>>(solutionsCount);
+        if (solutionsCount > 0)
+        {
+            queue->submit([&](sycl::handler &handler){
+                sycl::accessor<SolutionCircle, 1, sycl::access::mode::read, sycl::access::target::device> solutionsAccessor(*solutionsBuffer, handler, sycl::range<1>(solutionsCount), sycl::read_only);
+                handler.copy(solutionsAccessor, solutions->data());
+            }).wait();
+        }
 #else
-        /// TODO come back to this, maybe no need to make the copy
+        const uint32_t solutionsCount = std::min(static_cast<uint32_t>((*solutionsCounterBuffer)[SOLUTIONS_COUNT_INDEX]), MAX_SOLUTIONS);
+        const bool solutionsOverflow = (*solutionsCounterBuffer)[SOLUTIONS_OVERFLOW_INDEX] != 0;
+
+        solutions = std::make_unique<std::vector<SolutionCircle>>(solutionsBuffer->begin(), solutionsBuffer->begin() + solutionsCount);
 #endif
+        if (solutionsOverflow)
+        {
+            INFO("Solutions buffer overflow in event " << eventBuffer->getEvent()->getId() << ", only first " << MAX_SOLUTIONS << " solutions are kept");
+        }
         return std::make_pair(eventBuffer->getEvent(), std::move(solutions));
     }
 
@@ -61,45 +175,56 @@ namespace HelixSolver
 
     void ComputingWorker::updateState()
     {
-#ifdef USE_SYCL
-        if (state == ComputingWorkerState::WAITING)
+        // completion is signalled by the host task scheduled after the kernel, no need to query the device
+        if (state != ComputingWorkerState::PROCESSING || !isCompleted())
             return;
-        sycl::info::event_command_status status = computingEvent.get_info<sycl::info::event::command_execution_status>();
-        state = status == sycl::info::event_command_status::complete ? ComputingWorkerState::COMPLETED : ComputingWorkerState::PROCESSING;
-#endif
+
+        // solutions of an event whose wedge points did not fit are incomplete, it is computed again with more memory
+        if (wedgePointsStorage->growToRequestedCapacity())
+        {
+            INFO("Wedge points of event " << eventBuffer->getEvent()->getId() << " did not fit, computing it again with capacity " << wedgePointsStorage->getView().capacity);
+            scheduleTasksToQueue();
+            return;
+        }
+        state = ComputingWorkerState::COMPLETED;
     }
 
     void ComputingWorker::scheduleTasksToQueue()
     {
-        std::vector<HelixSolver::Options> opt(1);
+        // one work-item per (phi wedge x eta wedge) and initial accumulator division within it
+        const uint32_t phiWorkItems = options.N_PHI_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint32_t etaWorkItems = options.N_ETA_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint32_t spacepointsCount = eventBuffer->getSize();
+        completed.store(false, std::memory_order_relaxed);
 
-        opt[0].ACC_X_PRECISION = config["phi_precision"];
-        opt[0].ACC_PT_PRECISION = config["pt_precision"];
+#ifdef USE_SYCL
+        INFO("Submitting");
+        queue->submit([&](sycl::handler &handler){
+            sycl::accessor<uint32_t, 1, sycl::access::mode::write, sycl::access::target::device> solutionsCounter(*solutionsCounterBuffer, handler, sycl::write_only, sycl::no_init);
+            handler.fill(solutionsCounter, 0u);
+        });
 
-        opt[0].N_PHI_WEDGE = config["n_phi_regions"];
-        opt[0].N_ETA_WEDGE = config["n_eta_regions"];
+        // line parameters are computed once per event columns, the adaptive kernel below depends on them through the buffers
+        if (!eventBuffer->hasLineParameters())
+        {
+            queue->submit([&](sycl::handler &handler){
+                sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> rs(*eventBuffer->getRBuffer(), handler, sycl::read_only);
 
-        opt[0].THRESHOLD_PT_THRESHOLD = config["threshold_pt_threshold"];
-        opt[0].LOW_PT_THRESHOLD = config["low_pt_threshold"];
-        opt[0].HIGH_PT_THRESHOLD = config["high_pt_threshold"];
+                sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> phis(*eventBuffer->getPhiBuffer(), handler, sycl::read_only);
 
-        opt[0].N_SIGMA_GAUSS = config["n_sigma_gauss"];
-        opt[0].STDEV_CORRECTION = config["stdev_correction"];
-        opt[0].MIN_LINES_GAUSS = config["min_lines_gauss"];
+                sycl::accessor<float, 1, sycl::access::mode::write, sycl::access::target::device> as(*eventBuffer->getABuffer(), handler, sycl::write_only, sycl::no_init);
 
-        opt[0].THRESHOLD_X_PRECISION = config["threshold_x_precision"];
-        opt[0].THRESHOLD_PT_PRECISION = config["threshold_pt_precision"];
-        opt[0].THRESHOLD_COUNTER = config["threshold_counter"];
+                sycl::accessor<float, 1, sycl::access::mode::write, sycl::access::target::device> bs(*eventBuffer->getBBuffer(), handler, sycl::write_only, sycl::no_init);
+                LineParametersKernel kernel(rs, phis, as, bs);
 
-#ifdef USE_SYCL
-        solutions = std::make_unique<std::vector<SolutionCircle>>();
-        solutions->insert(solutions->begin(), MAX_SOLUTIONS, SolutionCircle{});
-        solutionsBuffer = std::make_unique<sycl::buffer<SolutionCircle, 1>>(sycl::buffer<SolutionCircle, 1>(solutions->begin(), solutions->end()));
+                handler.parallel_for(sycl::range<1>(spacepointsCount), kernel);
+            });
+            eventBuffer->setLineParametersComputed();
+        }
 
-        OptionsBuffer optbuff(opt.data(), 1);
-        INFO("Submitting");
-        computingEvent = queue->submit([&](sycl::handler &handler){
-            sycl::accessor<HelixSolver::Options, 1, sycl::access::mode::read, sycl::access::target::device> opts(optbuff, handler, sycl::read_only);
+        // accessors of the adaptive kernel, solutions must be kept (no no_init) when an earlier kernel of the event wrote some
+        auto makeAdaptiveKernel = [&](sycl::handler &handler, const sycl::property_list &solutionsProperties){
+            sycl::accessor<HelixSolver::Options, 1, sycl::access::mode::read, sycl::access::target::device> opts(*optionsBuffer, handler, sycl::read_only);
 
             sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> rs(*eventBuffer->getRBuffer(), handler, sycl::read_only);
 
@@ -107,33 +232,195 @@ namespace HelixSolver
 
             sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> zs(*eventBuffer->getZBuffer(), handler, sycl::read_only);
 
-            sycl::accessor<SolutionCircle, 1, sycl::access::mode::write, sycl::access::target::device> solutions(*solutionsBuffer, handler, sycl::write_only);
-            AdaptiveHoughGpuKernel kernel(opts, rs, phis, zs, solutions);
+            sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> as(*eventBuffer->getABuffer(), handler, sycl::read_only);
+
+            sycl::accessor<float, 1, sycl::access::mode::read, sycl::access::target::device> bs(*eventBuffer->getBBuffer(), handler, sycl::read_only);
+
+            sycl::accessor<SolutionCircle, 1, sycl::access::mode::write, sycl::access::target::device> solutions(*solutionsBuffer, handler, sycl::write_only, solutionsProperties);
+
+            sycl::accessor<uint32_t, 1, sycl::access::mode::read_write, sycl::access::target::device> solutionsCounter(*solutionsCounterBuffer, handler, sycl::read_write);
+            return AdaptiveHoughGpuKernel(opts, spacepointsCount, rs, phis, zs, as, bs, solutions, solutionsCounter);
+        };
+
+        // kernels of all modes read wedges copied by WedgePointsKernel, the event is computed again when they do not fit
+        const WedgePointsView points = wedgePointsStorage->getView();
+        const sycl::event wedgePointsReset = queue->memset(points.top, 0, sizeof(DeviceCounter));
+        sycl::event event = queue->submit([&](sycl::handler &handler){
+            handler.depends_on(wedgePointsReset);
+            handler.parallel_for(sycl::range<2>(phiWorkItems, etaWorkItems), WedgePointsKernel(makeAdaptiveKernel(handler, {sycl::no_init}), points));
+        });
+
+        if (adaptiveKernelMode == AdaptiveKernelMode::DEPTH_FIRST)
+        {
+            computingEvent = queue->submit([&](sycl::handler &handler){
+                handler.depends_on(event);
+                handler.parallel_for(sycl::range<2>(phiWorkItems, etaWorkItems), DepthFirstHoughKernel(makeAdaptiveKernel(handler, {}), points));
+            });
+        }
+        else if (adaptiveKernelMode == AdaptiveKernelMode::STACKLESS)
+        {
+            computingEvent = queue->submit([&](sycl::handler &handler){
+                handler.depends_on(event);
+                handler.parallel_for(sycl::range<2>(phiWorkItems, etaWorkItems), StacklessHoughKernel(makeAdaptiveKernel(handler, {}), points));
+            });
+        }
+        else if (adaptiveKernelMode == AdaptiveKernelMode::WORK_GROUP)
+        {
+            computingEvent = queue->submit([&](sycl::handler &handler){
+                handler.depends_on(event);
+                const sycl::range<2> groupRange(WORK_GROUP_SIZE, 1);
+                handler.parallel_for(sycl::nd_range<2>(sycl::range<2>(phiWorkItems * WORK_GROUP_SIZE, etaWorkItems), groupRange), AdaptiveHoughGroupKernel(makeAdaptiveKernel(handler, {}), points, handler));
+            });
+        }
+        else if (adaptiveKernelMode == AdaptiveKernelMode::SECTION_QUEUE)
+        {
+            const SectionQueueView view = sectionQueueStorage->getView();
+            const uint32_t persistentWorkItems = queue->get_device().get_info<sycl::info::device::max_compute_units>() * SECTION_QUEUE_WORK_ITEMS_PER_COMPUTE_UNIT;
+            computingEvent = queue->submit([&](sycl::handler &handler){
+                handler.depends_on(event);
+                handler.parallel_for(sycl::range<1>(persistentWorkItems), SectionQueueKernel(makeAdaptiveKernel(handler, {}), points, view, persistentWorkItems));
+            });
+        }
+        else
+        {
+            // sizes of frontiers are known only on the device, a launch covers the largest possible one
+            const FrontierView frontier = frontierStorage->getView();
+            event = queue->submit([&](sycl::handler &handler){
+                handler.depends_on(event);
+                handler.fill(frontier.sizes, points.regionsCount, 1);
+            });
+            uint32_t levelRange = points.regionsCount;
+            for (uint32_t level = 0; level < frontierLevelsCount; ++level)
+            {
+                const bool lastLevel = level + 1 == frontierLevelsCount;
+                event = queue->submit([&](sycl::handler &handler){
+                    handler.depends_on(event);
+                    handler.parallel_for(sycl::range<1>(levelRange), FrontierKernel(makeAdaptiveKernel(handler, {}), points, frontier, level, lastLevel, FrontierKernel::Step::EVALUATE));
+                });
+                event = queue->submit([&](sycl::handler &handler){
+                    handler.depends_on(event);
+                    handler.parallel_for(sycl::nd_range<1>(sycl::range<1>(FRONTIER_SCAN_GROUP_SIZE), sycl::range<1>(FRONTIER_SCAN_GROUP_SIZE)), FrontierScanKernel(frontier, level));
+                });
+                event = queue->submit([&](sycl::handler &handler){
+                    handler.depends_on(event);
+                    handler.parallel_for(sycl::range<1>(levelRange), FrontierKernel(makeAdaptiveKernel(handler, {}), points, frontier, level, lastLevel, FrontierKernel::Step::EXPAND));
+                });
+                levelRange = std::min(4 * levelRange, FRONTIER_CAPACITY);
+            }
+            computingEvent = event;
+        }
 
-            // handler.parallel_for<class test_op>(sycl::range<2>(ADAPTIVE_KERNEL_INITIAL_DIVISIONS, ADAPTIVE_KERNEL_INITIAL_DIVISIONS),
-            // [=](sycl::item<2> regionID) {
-            //     auto d1 = regionID.get_id(0);
-            // });
-            handler.parallel_for(sycl::range<2>(ADAPTIVE_KERNEL_INITIAL_DIVISIONS, ADAPTIVE_KERNEL_INITIAL_DIVISIONS), kernel); 
+        queue->submit([&](sycl::handler &handler){
+            handler.depends_on(computingEvent);
+            handler.host_task([this](){ markCompleted(); });
         });
         INFO("Submitted");
 
         state = ComputingWorkerState::PROCESSING;
         eventBuffer->setState(EventBuffer::EventBufferState::PROCESSED);
 #else
-        // in pure CPU code we do not wait for anything
-        solutions = std::make_unique<std::vector<SolutionCircle>>(MAX_SOLUTIONS);
+        (*solutionsCounterBuffer)[SOLUTIONS_COUNT_INDEX] = 0;
+        (*solutionsCounterBuffer)[SOLUTIONS_OVERFLOW_INDEX] = 0;
 
-        AdaptiveHoughGpuKernel kernel(opt, *eventBuffer->getRBuffer(), *eventBuffer->getPhiBuffer(), *eventBuffer->getZBuffer(), *solutions);
-        for (uint8_t div1 = 0; div1 < ADAPTIVE_KERNEL_INITIAL_DIVISIONS; ++div1)
+        state = ComputingWorkerState::PROCESSING;
+        eventBuffer->setState(EventBuffer::EventBufferState::PROCESSED);
+
+        if (phiWorkItems * etaWorkItems == 0)
         {
-            for (uint8_t div2 = 0; div2 < ADAPTIVE_KERNEL_INITIAL_DIVISIONS; ++div2)
-            {
-                kernel({div1, div2});
-            }
+            markCompleted();
+            return;
         }
-        state = ComputingWorkerState::COMPLETED;
+
+        AdaptiveHoughGpuKernel kernel(*optionsBuffer, spacepointsCount, eventBuffer->getRBuffer(), eventBuffer->getPhiBuffer(), eventBuffer->getZBuffer(), eventBuffer->getABuffer()->data(), eventBuffer->getBBuffer()->data(), *solutionsBuffer, *solutionsCounterBuffer);
+        // same steps as the SYCL kernels, the last task of a step submits the next one
+        const WedgePointsView points = wedgePointsStorage->getView();
+        points.top->store(0, std::memory_order_relaxed);
+        const WedgePointsKernel wedgePointsKernel(kernel, points);
+        submitTasks(points.regionsCount, 1, [wedgePointsKernel, points](uint32_t regionIndex){
+            wedgePointsKernel({static_cast<int>(regionIndex / points.etaRegionsCount), static_cast<int>(regionIndex % points.etaRegionsCount)});
+        }, [this, kernel](){
+            if (adaptiveKernelMode == AdaptiveKernelMode::SECTION_QUEUE)
+                scheduleSectionQueueTasks(kernel);
+            else if (adaptiveKernelMode == AdaptiveKernelMode::FRONTIER)
+                scheduleFrontierLevelTasks(kernel, 0);
+            else
+                scheduleRegionTasks(kernel);
+        });
 #endif
     }
 
+#ifndef USE_SYCL
+    void ComputingWorker::submitTasks(uint32_t count, uint32_t tasksSize, std::function<void(uint32_t)> task, std::function<void()> completion)
+    {
+        const uint32_t tasksCount = (count + tasksSize - 1) / tasksSize;
+        if (tasksCount == 0)
+        {
+            completion();
+            return;
+        }
+
+        pendingWorkItems.store(tasksCount, std::memory_order_relaxed);
+        for (uint32_t begin = 0; begin < count; begin += tasksSize)
+        {
+            const uint32_t end = std::min(begin + tasksSize, count);
+            queue->submit([this, begin, end, task, completion](){
+                for (uint32_t index = begin; index < end; ++index)
+                    task(index);
+                if (pendingWorkItems.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    completion();
+            });
+        }
+    }
+
+    void ComputingWorker::scheduleRegionTasks(const AdaptiveHoughGpuKernel &kernel)
+    {
+        const WedgePointsView points = wedgePointsStorage->getView();
+        std::function<void(Index2D)> regionKernel;
+        if (adaptiveKernelMode == AdaptiveKernelMode::WORK_GROUP)
+            regionKernel = AdaptiveHoughGroupKernel(kernel, points);
+        else if (adaptiveKernelMode == AdaptiveKernelMode::STACKLESS)
+            regionKernel = StacklessHoughKernel(kernel, points);
+        else
+            regionKernel = DepthFirstHoughKernel(kernel, points);
+        submitTasks(points.regionsCount, 1, [regionKernel, points](uint32_t regionIndex){
+            regionKernel({static_cast<int>(regionIndex / points.etaRegionsCount), static_cast<int>(regionIndex % points.etaRegionsCount)});
+        }, [this](){ markCompleted(); });
+    }
+
+    void ComputingWorker::scheduleSectionQueueTasks(const AdaptiveHoughGpuKernel &kernel)
+    {
+        const WedgePointsView points = wedgePointsStorage->getView();
+        const SectionQueueView view = sectionQueueStorage->getView();
+        const uint32_t persistentWorkItems = std::max(1u, std::thread::hardware_concurrency());
+        const SectionQueueKernel sectionQueueKernel(kernel, points, view, persistentWorkItems);
+        submitTasks(persistentWorkItems, 1, sectionQueueKernel, [this](){ markCompleted(); });
+    }
+
+    void ComputingWorker::scheduleFrontierLevelTasks(const AdaptiveHoughGpuKernel &kernel, uint32_t level)
+    {
+        const WedgePointsView points = wedgePointsStorage->getView();
+        const FrontierView frontier = frontierStorage->getView();
+        if (level == 0)
+            frontier.sizes[0] = points.regionsCount;
+        const uint32_t size = frontier.sizes[level];
+        if (size == 0)
+        {
+            markCompleted();
+            return;
+        }
+
+        const bool lastLevel = level + 1 == frontierLevelsCount;
+        const FrontierKernel evaluateKernel(kernel, points, frontier, level, lastLevel, FrontierKernel::Step::EVALUATE);
+        const FrontierKernel expandKernel(kernel, points, frontier, level, lastLevel, FrontierKernel::Step::EXPAND);
+        submitTasks(size, FRONTIER_TASK_SIZE, evaluateKernel, [this, kernel, frontier, level, lastLevel, size, expandKernel](){
+            FrontierScanKernel(frontier, level)();
+            submitTasks(size, FRONTIER_TASK_SIZE, expandKernel, [this, kernel, level, lastLevel](){
+                if (lastLevel)
+                    markCompleted();
+                else
+                    scheduleFrontierLevelTasks(kernel, level + 1);
+            });
+        });
+    }
+#endif
 } // namespace HelixSolver
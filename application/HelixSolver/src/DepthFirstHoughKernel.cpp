@@ -0,0 +1,63 @@
+#ifndef USE_SYCL
+#include <iostream>
+#endif
+
+#include "Debug/Debug.h"
+#include "HelixSolver/DepthFirstHoughKernel.h"
+
+namespace HelixSolver
+{
+    DepthFirstHoughKernel::DepthFirstHoughKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points)
+        : kernel(kernel), points(points)
+    {
+    }
+
+    void DepthFirstHoughKernel::operator()(Index2D idx) const
+    {
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(idx);
+        const uint32_t regionIndex = points.getRegionIndex(idx[0], idx[1]);
+        const uint32_t wedge_spacepoints_count = points.regionCounts[regionIndex];
+
+        CDEBUG(DISPLAY_N_WEDGE, idx[0] / ADAPTIVE_KERNEL_INITIAL_DIVISIONS << "," << idx[1] / ADAPTIVE_KERNEL_INITIAL_DIVISIONS << ","
+                                                << wedge_spacepoints_count
+                                                << ":WedgeCounts");
+        // do not conduct alogorithm calculations for empty region
+        if (wedge_spacepoints_count == 0)
+            return;
+
+        CDEBUG(DISPLAY_BASIC, " .. AdaptiveHoughKernel initiated for subregion "
+                                  << idx[0] << " " << idx[1]);
+
+        float *rs_wedge = points.rs + points.regionBegins[regionIndex];
+        float *phis_wedge = points.phis + points.regionBegins[regionIndex];
+        float *as_wedge = points.as + points.regionBegins[regionIndex];
+        float *bs_wedge = points.bs + points.regionBegins[regionIndex];
+
+        // the size os somewhat arbitrary, for regular algorithm dividing into 4
+        // sub-sections it defined by the depth allowed but for more flexible
+        // algorithms that is less predictable for now it is an arbitrary
+        // constant + checks that we stay within this limit
+        CompactSection
+            sections[MAX_SECTIONS_BUFFER_SIZE]; // in here sections of image
+                                                // will be recorded
+
+        // lines crossing sections which are on the stack, the arena is the slice of
+        // the wedge, the initial section uses all lines of the wedge so it starts empty
+        uint32_t *candidates = points.candidates + WEDGE_CANDIDATES_PER_POINT * points.regionBegins[regionIndex];
+        const uint32_t candidatesCapacity = WEDGE_CANDIDATES_PER_POINT * wedge_spacepoints_count;
+        uint32_t candidatesTop = 0;
+
+        uint32_t sectionsBufferSize = 1;
+        sections[0] = CompactSection();
+
+        // scan this region until there is no section to process (i.e. size,
+        // initially 1, becomes 0)
+        while (sectionsBufferSize)
+        {
+            kernel.fillAccumulatorSection(sections, sectionsBufferSize, region.initialSection, candidates, candidatesTop, candidatesCapacity, rs_wedge,
+                                          phis_wedge, as_wedge, bs_wedge,
+                                          region.wedgePhiCenter, region.wedgeEtaCenter,
+                                          wedge_spacepoints_count);
+        }
+    }
+} // namespace HelixSolver
@@ -1,54 +1,64 @@
-#include <fstream>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
-#include <TFile.h>
-#include <TTree.h>
 
-#include "Debug/Debug.h"
 #include "HelixSolver/Event.h"
 
 namespace HelixSolver
 {
-    Event::Event(EventId id, std::unique_ptr<std::vector<Point>> Points)
-        : id(id), Points(std::move(Points))
+    Event Event::fromCartesian(EventId id, uint32_t size, const float *xs, const float *ys, const float *zs)
     {
-        buildPointsFunctions();
+        Arena arena = allocateArena(size);
+
+        // separate passes over the columns, so that each loop can be vectorised
+        for (uint32_t i = 0; i < size; ++i)
+            arena.rs[i] = std::sqrt(xs[i] * xs[i] + ys[i] * ys[i]);
+        for (uint32_t i = 0; i < size; ++i)
+            arena.phis[i] = std::atan2(ys[i], xs[i]);
+        std::copy(zs, zs + size, arena.zs);
+        std::fill(arena.layers, arena.layers + size, 0);
+
+        return Event(id, size, arena.rs, arena.phis, arena.zs, arena.layers, std::move(arena.memory));
     }
 
-    Event::Event(const Event &other)
-        : id(other.id)
+    Event Event::fromPolar(EventId id, uint32_t size, const float *rs, const float *phis, const float *zs, const uint8_t *layers)
     {
-        Points = std::make_unique<std::vector<Point>>();
-        for (const Point &Point : *other.Points)
-        {
-            Points->push_back(Point);
-        }
-        buildPointsFunctions();
+        Arena arena = allocateArena(size);
+
+        std::copy(rs, rs + size, arena.rs);
+        std::copy(phis, phis + size, arena.phis);
+        std::copy(zs, zs + size, arena.zs);
+        std::copy(layers, layers + size, arena.layers);
+
+        return Event(id, size, arena.rs, arena.phis, arena.zs, arena.layers, std::move(arena.memory));
     }
 
-    void Event::print() const
+    Event::Event(EventId id, uint32_t size, const float *rs, const float *phis, const float *zs, const uint8_t *layers, std::shared_ptr<const void> storage)
+        : id(id), size(size), rs(rs), phis(phis), zs(zs), layers(layers), storage(std::move(storage))
     {
-        std::cout.precision(64);
-        for (const Point &Point : *Points)
-        {
-            std::cout << Point.x << " " << Point.y << " " << Point.z << std::endl;
-        }
     }
 
-    const std::vector<std::function<float(float)>> &Event::getPointsFuncs() const
+    Event Event::replicate(EventId replicaId) const
     {
-        return PointsFunctions;
+        return Event(replicaId, size, rs, phis, zs, layers, storage);
     }
 
-    void Event::buildPointsFunctions()
+    Event::Arena Event::allocateArena(uint32_t size)
     {
-        for (const Point &Point : *Points)
+        // layers are rounded up to whole floats
+        const uint32_t layersFloats = (size * sizeof(uint8_t) + sizeof(float) - 1) / sizeof(float);
+        std::shared_ptr<float[]> memory(new float[3 * size + layersFloats]);
+        float *rs = memory.get();
+
+        return Arena{std::move(memory), rs, rs + size, rs + 2 * size, reinterpret_cast<uint8_t *>(rs + 3 * size)};
+    }
+
+    void Event::print() const
+    {
+        std::cout.precision(64);
+        for (uint32_t i = 0; i < size; ++i)
         {
-            const float r = sqrt(Point.x * Point.x + Point.y * Point.y);
-            const float phi = atan2(Point.y, Point.x);
-            rs.push_back(r);
-            phis.push_back(phi);
-            zs.push_back(Point.z);
-            layers.push_back(Point.layer);
+            std::cout << rs[i] << " " << phis[i] << " " << zs[i] << std::endl;
         }
     }
 
@@ -57,22 +67,33 @@ namespace HelixSolver
         return id;
     }
 
-    std::vector<float> &Event::getR()
+    uint32_t Event::getSize() const
+    {
+        return size;
+    }
+
+    const float *Event::getR() const
     {
         return rs;
     }
 
-    std::vector<float> &Event::getPhi()
+    const float *Event::getPhi() const
     {
         return phis;
     }
-    std::vector<float> &Event::getZ()
+
+    const float *Event::getZ() const
     {
         return zs;
     }
 
-    std::vector<uint8_t> &Event::getLayers()
+    const uint8_t *Event::getLayers() const
     {
         return layers;
     }
+
+    const std::shared_ptr<const void> &Event::getStorage() const
+    {
+        return storage;
+    }
 } // namespace HelixSolver
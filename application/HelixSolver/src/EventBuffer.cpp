@@ -1,4 +1,5 @@
 #include "HelixSolver/EventBuffer.h"
+#include "HelixSolver/LineParametersKernel.h"
 
 namespace HelixSolver
 {
@@ -16,32 +17,128 @@ namespace HelixSolver
     {
         if (state != EventBufferState::FREE) return false;
 
+        // columns of replicas of the loaded event are already bound, their device copy, if any, is reused
+        if (!holdsColumnsOf(*event))
+        {
+            size = event->getSize();
+            lineParametersComputed = false;
+            // line parameters buffers are kept between events, they only grow for event larger than any seen so far
+            if (size > capacity) reserve(size);
+
+            // columns of the previous event are released before the event itself
+#ifdef USE_SYCL
+            rBuffer = bindColumn(event->getR(), size);
+            phiBuffer = bindColumn(event->getPhi(), size);
+            zBuffer = bindColumn(event->getZ(), size);
+#else
+            rBuffer = event->getR();
+            phiBuffer = event->getPhi();
+            zBuffer = event->getZ();
+#endif
+        }
+
+#ifndef USE_SYCL
+        if (!lineParametersComputed)
+        {
+            aBuffer->resize(size);
+            bBuffer->resize(size);
+            LineParametersKernel lineParametersKernel(rBuffer, phiBuffer, *aBuffer, *bBuffer);
+            for (uint32_t index = 0; index < size; ++index)
+            {
+                lineParametersKernel(index);
+            }
+            lineParametersComputed = true;
+        }
+#endif
         this->event = event;
-        rBuffer = std::make_shared<FloatBuffer>(FloatBuffer(event->getR().begin(), event->getR().end()));
-        phiBuffer = std::make_shared<FloatBuffer>(FloatBuffer(event->getPhi().begin(), event->getPhi().end()));
-        zBuffer = std::make_shared<FloatBuffer>(FloatBuffer(event->getZ().begin(), event->getZ().end()));
 
         state = EventBufferState::READY;
 
         return true;
     }
 
+    bool EventBuffer::holdsColumnsOf(const Event &event) const
+    {
+        return this->event != nullptr && this->event->getR() == event.getR() && this->event->getPhi() == event.getPhi()
+            && this->event->getZ() == event.getZ() && size == event.getSize();
+    }
+
+    bool EventBuffer::hasLineParameters() const
+    {
+        return lineParametersComputed;
+    }
+
+    void EventBuffer::setLineParametersComputed()
+    {
+        lineParametersComputed = true;
+    }
+
+    void EventBuffer::reserve(uint32_t spacepointsCapacity)
+    {
+        if (spacepointsCapacity <= capacity) return;
+
+        capacity = spacepointsCapacity;
+        lineParametersComputed = false;
+#ifdef USE_SYCL
+        aBuffer = std::make_shared<FloatBuffer>(sycl::range<1>(capacity));
+        bBuffer = std::make_shared<FloatBuffer>(sycl::range<1>(capacity));
+#else
+        for (std::shared_ptr<FloatBuffer> *buffer : {&aBuffer, &bBuffer})
+        {
+            *buffer = std::make_shared<FloatBuffer>();
+            (*buffer)->reserve(capacity);
+        }
+#endif
+    }
+
+    uint32_t EventBuffer::getSize() const
+    {
+        return size;
+    }
+
+    uint32_t EventBuffer::getCapacity() const
+    {
+        return capacity;
+    }
+
+#ifdef USE_SYCL
+    SpacepointsColumn EventBuffer::bindColumn(const float *values, uint32_t count)
+    {
+        // zero sized buffers are not portable, nothing is read from the buffer of an empty event
+        if (count == 0) return std::make_shared<FloatBuffer>(sycl::range<1>(1));
+
+        // use_host_ptr lets the runtime read the event memory directly instead of copying it to its own storage first,
+        // data is const so nothing is written back when the buffer is destroyed
+        return std::make_shared<FloatBuffer>(values, sycl::range<1>(count), sycl::property_list{sycl::property::buffer::use_host_ptr()});
+    }
+#endif
+
     std::shared_ptr<Event> EventBuffer::getEvent()
     {
         return event;
     }
 
-    std::shared_ptr<FloatBuffer> EventBuffer::getRBuffer() const
+    SpacepointsColumn EventBuffer::getRBuffer() const
     {
         return rBuffer;
     }
 
-    std::shared_ptr<FloatBuffer> EventBuffer::getPhiBuffer() const
+    SpacepointsColumn EventBuffer::getPhiBuffer() const
     {
         return phiBuffer;
     }
-    std::shared_ptr<FloatBuffer> EventBuffer::getZBuffer() const
+    SpacepointsColumn EventBuffer::getZBuffer() const
     {
         return zBuffer;
     }
+
+    std::shared_ptr<FloatBuffer> EventBuffer::getABuffer() const
+    {
+        return aBuffer;
+    }
+
+    std::shared_ptr<FloatBuffer> EventBuffer::getBBuffer() const
+    {
+        return bBuffer;
+    }
 } // namespace HelixSolver
@@ -0,0 +1,193 @@
+#ifndef USE_SYCL
+#include <iostream>
+#include <numeric>
+#endif
+
+#include "Debug/Debug.h"
+#include "HelixSolver/FrontierKernel.h"
+
+namespace HelixSolver
+{
+    namespace
+    {
+        // children of a section are written to the next frontier only when all of them fit, so it ends with the
+        // last block of children which fits completely, ends of the blocks grow with the index of the section
+        uint32_t getNextFrontierSize(const FrontierView &frontier, uint32_t size)
+        {
+            const uint32_t total = size > 0 ? frontier.childrenOffsets[size - 1] + frontier.childrenCounts[size - 1] : 0;
+            if (total <= FRONTIER_CAPACITY)
+                return total;
+
+            uint32_t first = 0;
+            uint32_t last = size - 1;
+            while (first < last)
+            {
+                const uint32_t middle = (first + last) / 2;
+                if (frontier.childrenOffsets[middle] + frontier.childrenCounts[middle] > FRONTIER_CAPACITY)
+                    last = middle;
+                else
+                    first = middle + 1;
+            }
+            return frontier.childrenOffsets[first];
+        }
+    } // namespace
+
+#ifdef USE_SYCL
+    FrontierStorage::FrontierStorage(sycl::queue &queue, uint32_t levelsCount)
+        : queue(queue)
+    {
+        view.sections = sycl::malloc_device<RegionSection>(2 * FRONTIER_CAPACITY, queue);
+        view.childrenCounts = sycl::malloc_device<uint32_t>(FRONTIER_CAPACITY, queue);
+        view.childrenOffsets = sycl::malloc_device<uint32_t>(FRONTIER_CAPACITY, queue);
+        view.sizes = sycl::malloc_device<uint32_t>(levelsCount + 1, queue);
+        ASSURE_THAT(view.sections && view.childrenCounts && view.childrenOffsets && view.sizes, "Frontier device memory allocation failed");
+    }
+
+    FrontierStorage::~FrontierStorage()
+    {
+        sycl::free(view.sections, queue);
+        sycl::free(view.childrenCounts, queue);
+        sycl::free(view.childrenOffsets, queue);
+        sycl::free(view.sizes, queue);
+    }
+#else
+    FrontierStorage::FrontierStorage(uint32_t levelsCount)
+        : sections(2 * FRONTIER_CAPACITY)
+        , children(2 * FRONTIER_CAPACITY)
+        , sizes(levelsCount + 1)
+    {
+        view = FrontierView{sections.data(), children.data(), children.data() + FRONTIER_CAPACITY, sizes.data()};
+    }
+
+    FrontierStorage::~FrontierStorage() = default;
+#endif
+
+    const FrontierView &FrontierStorage::getView() const
+    {
+        return view;
+    }
+
+    FrontierKernel::FrontierKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, const FrontierView &frontier,
+                                   uint32_t level, bool lastLevel, Step step)
+        : kernel(kernel), points(points), frontier(frontier), level(level), lastLevel(lastLevel), step(step)
+    {
+    }
+
+    void FrontierKernel::operator()(Index1D idx) const
+    {
+        // launches cover the largest possible frontier of the level, its size is known only on the device
+        const uint32_t index = static_cast<uint32_t>(idx);
+        if (index >= frontier.sizes[level])
+            return;
+
+        if (step == Step::EVALUATE)
+            evaluate(index);
+        else
+            expand(index);
+    }
+
+    RegionSection FrontierKernel::getSection(uint32_t index) const
+    {
+        if (level > 0)
+            return frontier.getFrontier(level)[index];
+
+        const uint16_t regionPhi = index / points.etaRegionsCount;
+        const uint16_t regionEta = index % points.etaRegionsCount;
+        return RegionSection::fromSection(regionPhi, regionEta, CompactSection());
+    }
+
+    void FrontierKernel::evaluate(uint32_t index) const
+    {
+        frontier.childrenCounts[index] = 0;
+        const RegionSection regionSection = getSection(index);
+        const uint32_t regionIndex = points.getRegionIndex(regionSection.regionPhi, regionSection.regionEta);
+        const uint32_t wedge_spacepoints_count = points.regionCounts[regionIndex];
+        if (wedge_spacepoints_count == 0)
+            return;
+
+        float *rs_wedge = points.rs + points.regionBegins[regionIndex];
+        float *phis_wedge = points.phis + points.regionBegins[regionIndex];
+        const float *as_wedge = points.as + points.regionBegins[regionIndex];
+        const float *bs_wedge = points.bs + points.regionBegins[regionIndex];
+
+        // lists of crossing lines are not kept for sections in the frontier
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(Index2D{regionSection.regionPhi, regionSection.regionEta});
+        const CompactSection compactSection = regionSection.toSection();
+        AccumulatorSection section = compactSection.toSection(region.initialSection);
+        uint32_t crossingCount = 0;
+        uint16_t count = kernel.countHits(section, nullptr, 0, 0, crossingCount, as_wedge, bs_wedge, wedge_spacepoints_count);
+        if (section.divisionLevel >= THRESHOLD_DIVISION_LEVEL_COUNT_HITS_ORDER_CHECK && count < MAX_COUNT_PER_SECTION)
+            count = kernel.countHits_checkOrder(section, nullptr, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+
+        if (!kernel.isAboveThreshold(section, count))
+            return;
+
+        CompactSection children[4];
+        uint32_t childrenCount = 0;
+        if (!kernel.pushChildren(children, childrenCount, compactSection, section, AccumulatorSection::ALL_CANDIDATES, 0))
+        {
+            kernel.addSolutionIfPeak(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, region.wedgePhiCenter, region.wedgeEtaCenter);
+            return;
+        }
+        frontier.childrenCounts[index] = childrenCount;
+    }
+
+    void FrontierKernel::expand(uint32_t index) const
+    {
+        const uint32_t childrenCount = frontier.childrenCounts[index];
+        if (childrenCount == 0)
+            return;
+
+        // children are split again from the section geometry, the same way as in evaluate
+        const RegionSection regionSection = getSection(index);
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(Index2D{regionSection.regionPhi, regionSection.regionEta});
+        const CompactSection compactSection = regionSection.toSection();
+        CompactSection sections[MAX_SECTIONS_BUFFER_SIZE];
+        uint32_t sectionsBufferSize = 0;
+        kernel.pushChildren(sections, sectionsBufferSize, compactSection, compactSection.toSection(region.initialSection), AccumulatorSection::ALL_CANDIDATES, 0);
+
+        const uint32_t offset = frontier.childrenOffsets[index];
+        if (!lastLevel && offset + childrenCount <= FRONTIER_CAPACITY)
+        {
+            RegionSection *next = frontier.getFrontier(level + 1);
+            for (uint32_t child = 0; child < childrenCount; ++child)
+                next[offset + child] = RegionSection::fromSection(regionSection.regionPhi, regionSection.regionEta, sections[child]);
+            return;
+        }
+
+        const uint32_t regionIndex = points.getRegionIndex(regionSection.regionPhi, regionSection.regionEta);
+        uint32_t candidatesTop = 0;
+        while (sectionsBufferSize)
+        {
+            kernel.fillAccumulatorSection(sections, sectionsBufferSize, region.initialSection, nullptr, candidatesTop, 0,
+                                          points.rs + points.regionBegins[regionIndex], points.phis + points.regionBegins[regionIndex],
+                                          points.as + points.regionBegins[regionIndex], points.bs + points.regionBegins[regionIndex],
+                                          region.wedgePhiCenter, region.wedgeEtaCenter, points.regionCounts[regionIndex]);
+        }
+    }
+
+    FrontierScanKernel::FrontierScanKernel(const FrontierView &frontier, uint32_t level)
+        : frontier(frontier), level(level)
+    {
+    }
+
+#ifdef USE_SYCL
+    void FrontierScanKernel::operator()(sycl::nd_item<1> item) const
+    {
+        const uint32_t size = frontier.sizes[level];
+        const sycl::group<1> group = item.get_group();
+        sycl::joint_exclusive_scan(group, frontier.childrenCounts, frontier.childrenCounts + size, frontier.childrenOffsets, 0u, sycl::plus<uint32_t>());
+        sycl::group_barrier(group);
+        if (group.leader())
+            frontier.sizes[level + 1] = getNextFrontierSize(frontier, size);
+    }
+#else
+    void FrontierScanKernel::operator()() const
+    {
+        const uint32_t size = frontier.sizes[level];
+        std::exclusive_scan(frontier.childrenCounts, frontier.childrenCounts + size, frontier.childrenOffsets, 0u);
+        frontier.sizes[level + 1] = getNextFrontierSize(frontier, size);
+        CDEBUG(DISPLAY_FRONTIER, level << "," << size << "," << frontier.sizes[level + 1] << ":FrontierSizes");
+    }
+#endif
+} // namespace HelixSolver
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "HelixSolver/HelixFinder.h"
+#include "HelixSolver/AdaptiveHoughGpuKernel.h"
+#include "HelixSolver/Constants.h"
+#include "HelixSolver/DepthFirstHoughKernel.h"
+#include "HelixSolver/LineParametersKernel.h"
+#include "HelixSolver/ProcessingQueue.h"
+#include "HelixSolver/WedgePoints.h"
+
+namespace HelixSolver
+{
+    HelixFinder::HelixFinder(const Options &options, uint32_t threadsCount)
+        : options(1, options)
+        , as(MAX_SPACEPOINTS)
+        , bs(MAX_SPACEPOINTS)
+        , solutions(MAX_SOLUTIONS)
+        , solutionsCounter(SOLUTIONS_COUNTER_SIZE)
+        , wedgePointsStorage(std::make_unique<WedgePointsStorage>(options.N_PHI_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS,
+                                                                  options.N_ETA_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS))
+    {
+        if (threadsCount != 1)
+            queue = std::make_unique<PromptCPUQueue>(std::make_shared<ThreadPool::WorkStealingThreadPool>(threadsCount));
+    }
+
+    HelixFinder::~HelixFinder() = default;
+
+    std::vector<SolutionCircle> HelixFinder::findHelices(const float *r, const float *phi, const float *z, size_t n)
+    {
+        if (n > MAX_SPACEPOINTS)
+            throw std::invalid_argument("Too many spacepoints: " + std::to_string(n) + ", at most " + std::to_string(MAX_SPACEPOINTS) + " are supported");
+        const uint32_t spacepointsCount = n;
+
+        LineParametersKernel lineParametersKernel(r, phi, as, bs);
+        for (uint32_t index = 0; index < spacepointsCount; ++index)
+            lineParametersKernel(index);
+
+        solutionsCounter[SOLUTIONS_COUNT_INDEX] = 0;
+        solutionsCounter[SOLUTIONS_OVERFLOW_INDEX] = 0;
+
+        const uint32_t phiWorkItems = options[0].N_PHI_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        const uint32_t etaWorkItems = options[0].N_ETA_WEDGE * ADAPTIVE_KERNEL_INITIAL_DIVISIONS;
+        AdaptiveHoughGpuKernel kernel(options, spacepointsCount, r, phi, z, as.data(), bs.data(), solutions, solutionsCounter);
+        auto runOnRegions = [&](const auto &regionKernel){
+            for (uint32_t idxPhi = 0; idxPhi < phiWorkItems; ++idxPhi)
+            {
+                for (uint32_t idxEta = 0; idxEta < etaWorkItems; ++idxEta)
+                {
+                    if (queue)
+                        queue->submit([regionKernel, idxPhi, idxEta](){ regionKernel({static_cast<int>(idxPhi), static_cast<int>(idxEta)}); });
+                    else
+                        regionKernel({static_cast<int>(idxPhi), static_cast<int>(idxEta)});
+                }
+            }
+            if (queue)
+                queue->wait();
+        };
+
+        // wedges are copied to the wedge points memory first, it grows until points of all of them fit
+        do
+        {
+            const WedgePointsView points = wedgePointsStorage->getView();
+            points.top->store(0, std::memory_order_relaxed);
+            runOnRegions(WedgePointsKernel(kernel, points));
+        } while (wedgePointsStorage->growToRequestedCapacity());
+        runOnRegions(DepthFirstHoughKernel(kernel, wedgePointsStorage->getView()));
+
+        const uint32_t solutionsCount = std::min(static_cast<uint32_t>(solutionsCounter[SOLUTIONS_COUNT_INDEX]), MAX_SOLUTIONS);
+        return std::vector<SolutionCircle>(solutions.begin(), solutions.begin() + solutionsCount);
+    }
+
+    std::vector<SolutionCircle> findHelices(const float *r, const float *phi, const float *z, size_t n, const Options &options)
+    {
+        return HelixFinder(options).findHelices(r, phi, z, n);
+    }
+} // namespace HelixSolver
@@ -0,0 +1,21 @@
+#include "HelixSolver/LineParametersKernel.h"
+#include "HelixSolver/Constants.h"
+
+namespace HelixSolver
+{
+    LineParametersKernel::LineParametersKernel(FloatBufferReadAccessor rs,
+                                               FloatBufferReadAccessor phis,
+                                               FloatBufferWriteAccessor as,
+                                               FloatBufferWriteAccessor bs)
+        : rs(rs), phis(phis), as(as), bs(bs)
+    {
+    }
+
+    void LineParametersKernel::operator()(Index1D idx) const
+    {
+        const float inverse_r = 1.0 / rs[idx];
+        const float a = inverse_r * INVERSE_A;
+        as[idx] = a;
+        bs[idx] = -a * phis[idx];
+    }
+} // namespace HelixSolver
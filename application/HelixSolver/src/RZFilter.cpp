@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+
+#include "HelixSolver/Constants.h"
+#include "HelixSolver/RZFilter.h"
+
+namespace HelixSolver
+{
+    RZFilter::Regions::Regions(const std::vector<Region> &regions)
+    {
+        for (const Region &region : regions)
+        {
+            rMins.push_back(region[0]);
+            rMaxs.push_back(region[1]);
+            zMins.push_back(region[2]);
+            zMaxs.push_back(region[3]);
+        }
+    }
+
+    RZFilter::RZFilter(const std::vector<Region> &excludedRegions, const std::vector<Region> &eventExclusionRegions)
+        : excludedRegions(excludedRegions), eventExclusionRegions(eventExclusionRegions)
+    {
+    }
+
+    std::optional<uint32_t> RZFilter::filter(uint32_t size, float *xs, float *ys, float *zs) const
+    {
+        float rs[RZ_FILTER_BLOCK_SIZE];
+        uint8_t excluded[RZ_FILTER_BLOCK_SIZE];
+        uint32_t kept = 0;
+        for (uint32_t begin = 0; begin < size; begin += RZ_FILTER_BLOCK_SIZE)
+        {
+            const uint32_t count = std::min(size - begin, RZ_FILTER_BLOCK_SIZE);
+            for (uint32_t i = 0; i < count; ++i)
+                rs[i] = std::sqrt(xs[begin + i] * xs[begin + i] + ys[begin + i] * ys[begin + i]);
+            if (classifyBlock(count, rs, zs + begin, excluded))
+                return std::nullopt;
+
+            // kept points never move forward, so compaction in place does not overwrite unread ones
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                xs[kept] = xs[begin + i];
+                ys[kept] = ys[begin + i];
+                zs[kept] = zs[begin + i];
+                kept += 1 - excluded[i];
+            }
+        }
+        return kept;
+    }
+
+    std::optional<uint32_t> RZFilter::classify(uint32_t size, const float *rs, const float *zs, uint8_t *excluded) const
+    {
+        uint32_t kept = 0;
+        for (uint32_t begin = 0; begin < size; begin += RZ_FILTER_BLOCK_SIZE)
+        {
+            const uint32_t count = std::min(size - begin, RZ_FILTER_BLOCK_SIZE);
+            if (classifyBlock(count, rs + begin, zs + begin, excluded + begin))
+                return std::nullopt;
+            for (uint32_t i = 0; i < count; ++i)
+                kept += 1 - excluded[begin + i];
+        }
+        return kept;
+    }
+
+    bool RZFilter::classifyBlock(uint32_t count, const float *rs, const float *zs, uint8_t *excluded) const
+    {
+        std::fill(excluded, excluded + count, 0);
+        for (uint32_t region = 0; region < excludedRegions.rMins.size(); ++region)
+        {
+            const float rMin = excludedRegions.rMins[region];
+            const float rMax = excludedRegions.rMaxs[region];
+            const float zMin = excludedRegions.zMins[region];
+            const float zMax = excludedRegions.zMaxs[region];
+            for (uint32_t i = 0; i < count; ++i)
+                excluded[i] |= (rMin < rs[i]) & (rs[i] < rMax) & (zMin < zs[i]) & (zs[i] < zMax);
+        }
+
+        // only points which are kept can exclude the event
+        uint8_t rejected = 0;
+        for (uint32_t region = 0; region < eventExclusionRegions.rMins.size(); ++region)
+        {
+            const float rMin = eventExclusionRegions.rMins[region];
+            const float rMax = eventExclusionRegions.rMaxs[region];
+            const float zMin = eventExclusionRegions.zMins[region];
+            const float zMax = eventExclusionRegions.zMaxs[region];
+            for (uint32_t i = 0; i < count; ++i)
+                rejected |= (1 - excluded[i]) & (rMin < rs[i]) & (rs[i] < rMax) & (zMin < zs[i]) & (zs[i] < zMax);
+        }
+        return rejected != 0;
+    }
+} // namespace HelixSolver
@@ -0,0 +1,170 @@
+#include "Debug/Debug.h"
+#include "HelixSolver/SectionQueueKernel.h"
+#include "HelixSolver/StacklessHoughKernel.h"
+
+namespace HelixSolver
+{
+    namespace
+    {
+        constexpr uint32_t SECTION_QUEUE_MASK = SECTION_QUEUE_CAPACITY - 1;
+
+        // slot at position can be written when its sequence equals position and read when it equals position + 1,
+        // positions only grow (modulo 2^32, a multiple of the capacity) so the sequence tells apart laps of the ring
+        bool enqueue(const SectionQueueView &view, const RegionSection &section)
+        {
+            uint32_t position = atomicLoad(view.counters[SECTION_QUEUE_TAIL_INDEX]);
+            while (true)
+            {
+                DeviceCounter &sequence = view.sequences[position & SECTION_QUEUE_MASK];
+                const int32_t difference = static_cast<int32_t>(atomicLoad(sequence) - position);
+                if (difference == 0 && atomicCompareExchange(view.counters[SECTION_QUEUE_TAIL_INDEX], position, position + 1))
+                {
+                    view.sections[position & SECTION_QUEUE_MASK] = section;
+                    atomicStore(sequence, position + 1);
+                    return true;
+                }
+                if (difference < 0)
+                    return false; // full
+                position = atomicLoad(view.counters[SECTION_QUEUE_TAIL_INDEX]);
+            }
+        }
+
+        bool dequeue(const SectionQueueView &view, RegionSection &section)
+        {
+            uint32_t position = atomicLoad(view.counters[SECTION_QUEUE_HEAD_INDEX]);
+            while (true)
+            {
+                DeviceCounter &sequence = view.sequences[position & SECTION_QUEUE_MASK];
+                const int32_t difference = static_cast<int32_t>(atomicLoad(sequence) - (position + 1));
+                if (difference == 0 && atomicCompareExchange(view.counters[SECTION_QUEUE_HEAD_INDEX], position, position + 1))
+                {
+                    section = view.sections[position & SECTION_QUEUE_MASK];
+                    atomicStore(sequence, position + SECTION_QUEUE_CAPACITY);
+                    return true;
+                }
+                if (difference < 0)
+                    return false; // empty, or the section is not written yet
+                position = atomicLoad(view.counters[SECTION_QUEUE_HEAD_INDEX]);
+            }
+        }
+    } // namespace
+
+#ifdef USE_SYCL
+    SectionQueueStorage::SectionQueueStorage(sycl::queue &queue)
+        : queue(queue)
+    {
+        view.sections = sycl::malloc_device<RegionSection>(SECTION_QUEUE_CAPACITY, queue);
+        view.sequences = sycl::malloc_device<DeviceCounter>(SECTION_QUEUE_CAPACITY, queue);
+        view.counters = sycl::malloc_device<DeviceCounter>(SECTION_QUEUE_COUNTERS_SIZE, queue);
+        ASSURE_THAT(view.sections && view.sequences && view.counters, "Section queue device memory allocation failed");
+
+        // the ring starts empty and it is empty again after every event
+        DeviceCounter *sequences = view.sequences;
+        queue.parallel_for(sycl::range<1>(SECTION_QUEUE_CAPACITY), [=](sycl::id<1> slot){ sequences[slot] = slot[0]; });
+        queue.memset(view.counters, 0, SECTION_QUEUE_COUNTERS_SIZE * sizeof(DeviceCounter));
+        queue.wait();
+    }
+
+    SectionQueueStorage::~SectionQueueStorage()
+    {
+        sycl::free(view.sections, queue);
+        sycl::free(view.sequences, queue);
+        sycl::free(view.counters, queue);
+    }
+#else
+    SectionQueueStorage::SectionQueueStorage()
+        : sections(SECTION_QUEUE_CAPACITY)
+        , sequences(SECTION_QUEUE_CAPACITY)
+        , counters(SECTION_QUEUE_COUNTERS_SIZE)
+    {
+        for (uint32_t slot = 0; slot < SECTION_QUEUE_CAPACITY; ++slot)
+            sequences[slot] = slot;
+
+        view = SectionQueueView{sections.data(), sequences.data(), counters.data()};
+    }
+
+    SectionQueueStorage::~SectionQueueStorage() = default;
+#endif
+
+    const SectionQueueView &SectionQueueStorage::getView() const
+    {
+        return view;
+    }
+
+    SectionQueueKernel::SectionQueueKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points, const SectionQueueView &view, uint32_t workItemsCount)
+        : kernel(kernel), points(points), view(view), workItemsCount(workItemsCount)
+    {
+    }
+
+    void SectionQueueKernel::operator()(Index1D idx) const
+    {
+        for (uint32_t regionIndex = static_cast<uint32_t>(idx); regionIndex < points.regionsCount; regionIndex += workItemsCount)
+        {
+            const uint16_t regionPhi = regionIndex / points.etaRegionsCount;
+            const uint16_t regionEta = regionIndex % points.etaRegionsCount;
+            if (points.regionCounts[regionIndex] == 0)
+                continue;
+
+            const RegionSection section = RegionSection::fromSection(regionPhi, regionEta, CompactSection());
+            if (!enqueue(view, section))
+                processSection(section);
+        }
+
+        // a work-item does not wait for sections of others, it returns once it finds the queue empty, sections
+        // enqueued later are taken by the work-items which enqueued them, the last of them leaves the queue empty
+        RegionSection section;
+        while (dequeue(view, section))
+            processSection(section);
+    }
+
+    void SectionQueueKernel::processSection(const RegionSection &regionSection) const
+    {
+        const uint32_t regionIndex = points.getRegionIndex(regionSection.regionPhi, regionSection.regionEta);
+        float *rs_wedge = points.rs + points.regionBegins[regionIndex];
+        float *phis_wedge = points.phis + points.regionBegins[regionIndex];
+        const float *as_wedge = points.as + points.regionBegins[regionIndex];
+        const float *bs_wedge = points.bs + points.regionBegins[regionIndex];
+        const uint32_t wedge_spacepoints_count = points.regionCounts[regionIndex];
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(Index2D{regionSection.regionPhi, regionSection.regionEta});
+
+        CompactSection sections[SECTION_QUEUE_LOCAL_STACK_SIZE];
+        uint32_t sectionsBufferSize = 1;
+        sections[0] = regionSection.toSection();
+
+        while (sectionsBufferSize)
+        {
+            sectionsBufferSize--;
+            const CompactSection compactSection = sections[sectionsBufferSize];
+            AccumulatorSection section = compactSection.toSection(region.initialSection);
+
+            // lists of crossing lines are not kept for sections in the queue
+            uint32_t crossingCount = 0;
+            uint16_t count = kernel.countHits(section, nullptr, 0, 0, crossingCount, as_wedge, bs_wedge, wedge_spacepoints_count);
+            if (section.divisionLevel >= THRESHOLD_DIVISION_LEVEL_COUNT_HITS_ORDER_CHECK && count < MAX_COUNT_PER_SECTION)
+                count = kernel.countHits_checkOrder(section, nullptr, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+
+            if (!kernel.isAboveThreshold(section, count))
+                continue;
+
+            CompactSection children[4];
+            uint32_t childrenCount = 0;
+            if (!kernel.pushChildren(children, childrenCount, compactSection, section, AccumulatorSection::ALL_CANDIDATES, 0))
+            {
+                kernel.addSolutionIfPeak(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, region.wedgePhiCenter, region.wedgeEtaCenter);
+                continue;
+            }
+
+            for (uint32_t child = 0; child < childrenCount; ++child)
+            {
+                if (enqueue(view, RegionSection::fromSection(regionSection.regionPhi, regionSection.regionEta, children[child])))
+                    continue;
+
+                if (sectionsBufferSize < SECTION_QUEUE_LOCAL_STACK_SIZE)
+                    sections[sectionsBufferSize++] = children[child];
+                else
+                    StacklessHoughKernel(kernel, points).walkSubtree(children[child], region.initialSection, rs_wedge, phis_wedge, as_wedge, bs_wedge,
+                                                                     wedge_spacepoints_count, region.wedgePhiCenter, region.wedgeEtaCenter);
+            }
+        }
+    }
+} // namespace HelixSolver
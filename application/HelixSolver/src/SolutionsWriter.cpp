@@ -0,0 +1,100 @@
+#include <TFile.h>
+#include <TTree.h>
+
+#include "HelixSolver/SolutionsWriter.h"
+#include "HelixSolver/Constants.h"
+#include "Debug/Debug.h"
+
+namespace HelixSolver
+{
+    SolutionsWriter::SolutionsWriter(const std::string &path, uint32_t queueDepth)
+        : path(path), eventsAndSolutions(queueDepth), writer(&SolutionsWriter::run, this) {}
+
+    SolutionsWriter::~SolutionsWriter()
+    {
+        eventsAndSolutions.close();
+        if (writer.joinable())
+            writer.join();
+    }
+
+    void SolutionsWriter::write(ComputingWorker::EventSoutionsPair &&eventAndSolutions)
+    {
+        eventsAndSolutions.push(std::move(eventAndSolutions));
+    }
+
+    void SolutionsWriter::close()
+    {
+        eventsAndSolutions.close();
+        if (writer.joinable())
+            writer.join();
+        if (writerException)
+            std::rethrow_exception(writerException);
+    }
+
+    void SolutionsWriter::run()
+    {
+        try
+        {
+            std::unique_ptr<TFile> file(TFile::Open((path + ".root").c_str(), "RECREATE")); // we overwrite output, maybe this is wrong idea? TODO, decide
+            if (file == nullptr)
+            {
+                throw std::runtime_error("Can't open output file: " + path + ".root");
+            }
+            uint32_t eventId{};
+            float phi{};
+            float pt{};
+            float q{};
+            float eta{};
+            float z{};
+            float d0{};
+            int nhits{};
+
+            // tree is owned by the file
+            TTree *outputTree = new TTree("solutions", "solutions");
+            outputTree->Branch("event_id", &eventId);
+            outputTree->Branch("phi", &phi);
+            outputTree->Branch("pt", &pt);
+            outputTree->Branch("eta", &eta);
+            outputTree->Branch("q", &q);
+            outputTree->Branch("z", &z);
+            outputTree->Branch("d0", &d0);
+            outputTree->Branch("nhits", &nhits);
+
+            uint32_t eventsWritten = 0;
+            while (std::optional<ComputingWorker::EventSoutionsPair> eventAndSolution = eventsAndSolutions.pop())
+            {
+                eventId = eventAndSolution->first->getId();
+
+                for (const SolutionCircle &solution : *eventAndSolution->second)
+                {
+                    if (solution.invalid())
+                        break;
+
+                    phi = solution.phi;
+                    pt = solution.pt;
+                    q = solution.q;
+                    eta = solution.eta;
+                    z = solution.z;
+                    d0 = solution.d0;
+                    nhits = solution.nhits;
+
+                    outputTree->Fill();
+                }
+
+                // flushes baskets and the tree header, so that memory stays bounded and a partial file is readable
+                if (++eventsWritten % SOLUTIONS_AUTOSAVE_EVENTS == 0)
+                    outputTree->AutoSave("SaveSelf");
+            }
+            DEBUG("Output data saved to file " + path + ".root");
+            file->Write();
+            file->Close();
+        }
+        catch (...)
+        {
+            writerException = std::current_exception();
+            // unblocks producers, remaining events are dropped
+            eventsAndSolutions.close();
+            while (eventsAndSolutions.pop());
+        }
+    }
+} // namespace HelixSolver
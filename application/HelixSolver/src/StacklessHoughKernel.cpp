@@ -0,0 +1,79 @@
+#ifndef USE_SYCL
+#include <iostream>
+#endif
+
+#include "Debug/Debug.h"
+#include "HelixSolver/StacklessHoughKernel.h"
+
+namespace HelixSolver
+{
+    StacklessHoughKernel::StacklessHoughKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points)
+        : kernel(kernel), points(points)
+    {
+    }
+
+    void StacklessHoughKernel::operator()(Index2D idx) const
+    {
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(idx);
+        const uint32_t regionIndex = points.getRegionIndex(idx[0], idx[1]);
+        const uint32_t wedge_spacepoints_count = points.regionCounts[regionIndex];
+
+        CDEBUG(DISPLAY_N_WEDGE, idx[0] << "," << idx[1] << "," << wedge_spacepoints_count << ":WedgeCounts");
+        if (wedge_spacepoints_count == 0)
+            return;
+
+        float *rs_wedge = points.rs + points.regionBegins[regionIndex];
+        float *phis_wedge = points.phis + points.regionBegins[regionIndex];
+        const float *as_wedge = points.as + points.regionBegins[regionIndex];
+        const float *bs_wedge = points.bs + points.regionBegins[regionIndex];
+        walkSubtree(CompactSection(), region.initialSection, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count,
+                    region.wedgePhiCenter, region.wedgeEtaCenter);
+    }
+
+    void StacklessHoughKernel::walkSubtree(const CompactSection &root, const AccumulatorSection &initialSection,
+                                           float *rs_wedge, float *phis_wedge, const float *as_wedge, const float *bs_wedge,
+                                           uint32_t wedge_spacepoints_count, float wedge_phi_center, float wedge_eta_center) const
+    {
+        CompactSection compactSection = root;
+        bool walking = true;
+        while (walking)
+        {
+            AccumulatorSection section = compactSection.toSection(initialSection);
+            CDEBUG(DISPLAY_BOX_POSITION, section.xBegin
+                                             << "," << section.yBegin << ","
+                                             << section.xBegin + section.xSize << ","
+                                             << section.yBegin + section.ySize << ","
+                                             << section.divisionLevel << ":BoxPosition");
+
+            uint32_t crossingCount = 0;
+            uint16_t count = kernel.countHits(section, nullptr, 0, 0, crossingCount, as_wedge, bs_wedge, wedge_spacepoints_count);
+            if (section.divisionLevel >= THRESHOLD_DIVISION_LEVEL_COUNT_HITS_ORDER_CHECK && count < MAX_COUNT_PER_SECTION)
+                count = kernel.countHits_checkOrder(section, nullptr, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count);
+
+            if (kernel.isAboveThreshold(section, count))
+            {
+                CompactSection child;
+                if (kernel.firstChild(compactSection, section, child))
+                {
+                    compactSection = child;
+                    continue;
+                }
+                kernel.addSolutionIfPeak(section, rs_wedge, phis_wedge, as_wedge, bs_wedge, wedge_spacepoints_count, wedge_phi_center, wedge_eta_center);
+            }
+            walking = nextSection(compactSection, root.divisionLevel);
+        }
+    }
+
+    bool StacklessHoughKernel::nextSection(CompactSection &section, uint8_t rootDivisionLevel) const
+    {
+        // subtrees of the last children are done together with their parents
+        while (section.divisionLevel > rootDivisionLevel && section.isLastChild())
+            section = section.parent();
+
+        if (section.divisionLevel == rootDivisionLevel)
+            return false;
+
+        section = section.nextSibling();
+        return true;
+    }
+} // namespace HelixSolver
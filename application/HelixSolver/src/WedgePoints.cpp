@@ -0,0 +1,133 @@
+#include "Debug/Debug.h"
+#include "HelixSolver/WedgePoints.h"
+
+namespace HelixSolver
+{
+#ifdef USE_SYCL
+    WedgePointsStorage::WedgePointsStorage(sycl::queue &queue, uint32_t phiRegionsCount, uint32_t etaRegionsCount)
+        : queue(queue)
+    {
+        const uint32_t regionsCount = phiRegionsCount * etaRegionsCount;
+        view = WedgePointsView{sycl::malloc_device<DeviceCounter>(1, queue), nullptr, nullptr, nullptr, nullptr, nullptr,
+                               sycl::malloc_device<uint32_t>(regionsCount, queue), sycl::malloc_device<uint32_t>(regionsCount, queue),
+                               0, etaRegionsCount, regionsCount};
+        ASSURE_THAT(view.top && view.regionBegins && view.regionCounts, "Wedge points device memory allocation failed");
+        allocatePoints(WEDGE_POINTS_CAPACITY);
+    }
+
+    WedgePointsStorage::~WedgePointsStorage()
+    {
+        for (void *memory : {static_cast<void *>(view.top), static_cast<void *>(view.rs), static_cast<void *>(view.phis),
+                             static_cast<void *>(view.as), static_cast<void *>(view.bs), static_cast<void *>(view.candidates),
+                             static_cast<void *>(view.regionBegins), static_cast<void *>(view.regionCounts)})
+        {
+            sycl::free(memory, queue);
+        }
+    }
+
+    bool WedgePointsStorage::growToRequestedCapacity()
+    {
+        DeviceCounter requested = 0;
+        queue.memcpy(&requested, view.top, sizeof(DeviceCounter)).wait();
+        if (requested <= view.capacity)
+            return false;
+
+        allocatePoints((requested / SPACEPOINTS_CAPACITY_GRANULARITY + 1) * SPACEPOINTS_CAPACITY_GRANULARITY);
+        return true;
+    }
+
+    void WedgePointsStorage::allocatePoints(uint32_t capacity)
+    {
+        // kernels of the worker are completed, none of them uses the old memory
+        for (float *memory : {view.rs, view.phis, view.as, view.bs})
+            sycl::free(memory, queue);
+        sycl::free(view.candidates, queue);
+
+        view.rs = sycl::malloc_device<float>(capacity, queue);
+        view.phis = sycl::malloc_device<float>(capacity, queue);
+        view.as = sycl::malloc_device<float>(capacity, queue);
+        view.bs = sycl::malloc_device<float>(capacity, queue);
+        view.candidates = sycl::malloc_device<uint32_t>(WEDGE_CANDIDATES_PER_POINT * static_cast<size_t>(capacity), queue);
+        view.capacity = capacity;
+        ASSURE_THAT(view.rs && view.phis && view.as && view.bs && view.candidates, "Wedge points device memory allocation failed");
+    }
+#else
+    WedgePointsStorage::WedgePointsStorage(uint32_t phiRegionsCount, uint32_t etaRegionsCount)
+        : top(0)
+        , regions(2 * phiRegionsCount * etaRegionsCount)
+    {
+        const uint32_t regionsCount = phiRegionsCount * etaRegionsCount;
+        view = WedgePointsView{&top, nullptr, nullptr, nullptr, nullptr, nullptr,
+                               regions.data(), regions.data() + regionsCount,
+                               0, etaRegionsCount, regionsCount};
+        allocatePoints(WEDGE_POINTS_CAPACITY);
+    }
+
+    WedgePointsStorage::~WedgePointsStorage() = default;
+
+    bool WedgePointsStorage::growToRequestedCapacity()
+    {
+        const uint32_t requested = top.load(std::memory_order_acquire);
+        if (requested <= view.capacity)
+            return false;
+
+        allocatePoints((requested / SPACEPOINTS_CAPACITY_GRANULARITY + 1) * SPACEPOINTS_CAPACITY_GRANULARITY);
+        return true;
+    }
+
+    void WedgePointsStorage::allocatePoints(uint32_t capacity)
+    {
+        points.assign(4 * static_cast<size_t>(capacity), 0.0f);
+        view.rs = points.data();
+        view.phis = points.data() + capacity;
+        view.as = points.data() + 2 * static_cast<size_t>(capacity);
+        view.bs = points.data() + 3 * static_cast<size_t>(capacity);
+        candidates.assign(WEDGE_CANDIDATES_PER_POINT * static_cast<size_t>(capacity), 0);
+        view.candidates = candidates.data();
+        view.capacity = capacity;
+    }
+#endif
+
+    const WedgePointsView &WedgePointsStorage::getView() const
+    {
+        return view;
+    }
+
+    WedgePointsKernel::WedgePointsKernel(const AdaptiveHoughGpuKernel &kernel, const WedgePointsView &points)
+        : kernel(kernel), points(points)
+    {
+    }
+
+    void WedgePointsKernel::operator()(Index2D idx) const
+    {
+        const AdaptiveHoughGpuKernel::WorkRegion region = kernel.getWorkRegion(idx);
+        const uint32_t regionIndex = points.getRegionIndex(idx[0], idx[1]);
+
+        // points are read twice, first to reserve space for all of them at once
+        float r, phi, a, b;
+        uint32_t wedge_spacepoints_count = 0;
+        for (uint32_t index = 0; index < kernel.spacepointsCount; ++index)
+        {
+            if (kernel.readWedgeSpacepoint(region.wedge, index, r, phi, a, b))
+                ++wedge_spacepoints_count;
+        }
+
+        points.regionCounts[regionIndex] = 0;
+        if (wedge_spacepoints_count == 0)
+            return;
+
+        // points of the regions which do not fit are still counted, so that the host can grow the memory to all of them
+        const uint32_t begin = atomicFetchAdd(*points.top, wedge_spacepoints_count);
+        if (begin + wedge_spacepoints_count > points.capacity)
+            return;
+
+        uint32_t position = begin;
+        for (uint32_t index = 0; index < kernel.spacepointsCount; ++index)
+        {
+            if (kernel.readWedgeSpacepoint(region.wedge, index, points.rs[position], points.phis[position], points.as[position], points.bs[position]))
+                ++position;
+        }
+        points.regionBegins[regionIndex] = begin;
+        points.regionCounts[regionIndex] = wedge_spacepoints_count;
+    }
+} // namespace HelixSolver
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "SharedMemoryRing/Producer.h"
+#include "SpacepointsFile/MappedReader.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input spacepoints.bin> [events ring] [results ring] [--stop]" << std::endl;
+        return EXIT_FAILURE;
+    }
+    const bool stopService = std::strcmp(argv[argc - 1], "--stop") == 0;
+    const int ringArgs = argc - 2 - (stopService ? 1 : 0);
+    const std::string eventsRingName = ringArgs > 0 ? argv[2] : "/helix_solver_events";
+    const std::string resultsRingName = ringArgs > 1 ? argv[3] : "/helix_solver_results";
+
+    const SpacepointsFile::MappedReader reader(argv[1]);
+    SharedMemoryRing::Producer producer(eventsRingName, resultsRingName);
+
+    using Clock = std::chrono::steady_clock;
+    std::mutex submitTimesMutex;
+    std::map<uint32_t, Clock::time_point> submitTimes;
+
+    // results come in order of completion, latency is measured from submission of the event
+    const uint32_t eventsCount = reader.getEventsCount();
+    std::thread receiver([&]()
+    {
+        for (uint32_t received = 0; received < eventsCount; ++received)
+        {
+            std::optional<SharedMemoryRing::Result> result = producer.receive();
+            if (!result)
+            {
+                std::cerr << "Service closed results before all events were processed" << std::endl;
+                return;
+            }
+            Clock::time_point submitTime;
+            {
+                std::lock_guard<std::mutex> lock(submitTimesMutex);
+                submitTime = submitTimes[result->eventId];
+            }
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - submitTime).count();
+            std::cout << "Event " << result->eventId << ": " << result->solutions.size() << " solutions"
+                      << (result->overflow ? " (truncated)" : "") << " in " << latency / 1e3 << " ms" << std::endl;
+        }
+    });
+
+    const Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < eventsCount; ++i)
+    {
+        const SpacepointsFile::EventView event = reader.getEvent(i);
+        {
+            std::lock_guard<std::mutex> lock(submitTimesMutex);
+            submitTimes[event.eventId] = Clock::now();
+        }
+        if (!producer.submit(event.eventId, event.pointsCount, event.rs, event.phis, event.zs, event.layers))
+        {
+            std::cerr << "Service does not accept events" << std::endl;
+            break;
+        }
+    }
+    receiver.join();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    std::cout << "Processed " << eventsCount << " events in " << elapsed / 1e3 << " ms" << std::endl;
+
+    if (stopService)
+    {
+        producer.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <TFile.h>
+#include <TTree.h>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "SpacepointsFile/Writer.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <input spacepoints.root> <output file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<TFile> file(TFile::Open(argv[1]));
+    if (file == nullptr)
+    {
+        std::cerr << "Can't open input file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::unique_ptr<TTree> hitsTree(file->Get<TTree>("spacepoints"));
+    if (hitsTree == nullptr)
+    {
+        std::cerr << "Can't access tree spacepoints in " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    uint32_t eventId;
+    float x;
+    float y;
+    float z;
+
+    hitsTree->SetBranchAddress("event_id", &eventId);
+    hitsTree->SetBranchAddress("x", &x);
+    hitsTree->SetBranchAddress("y", &y);
+    hitsTree->SetBranchAddress("z", &z);
+
+    SpacepointsFile::Writer writer(argv[2]);
+
+    uint32_t currentEventId = 0;
+    std::vector<float> rs;
+    std::vector<float> phis;
+    std::vector<float> zs;
+    std::vector<uint8_t> layers;
+    bool eventStarted = false;
+    uint32_t eventsCount = 0;
+
+    auto completeEvent = [&]()
+    {
+        if (!eventStarted)
+            return;
+        writer.addEvent(currentEventId, rs, phis, zs, layers);
+        ++eventsCount;
+        rs.clear();
+        phis.clear();
+        zs.clear();
+        layers.clear();
+    };
+
+    for (int i = 0; hitsTree->LoadTree(i) >= 0; i++)
+    {
+        hitsTree->GetEntry(i);
+        if (!eventStarted || eventId != currentEventId)
+        {
+            completeEvent();
+            currentEventId = eventId;
+            eventStarted = true;
+        }
+        // same conversion as in HelixSolver::Event
+        rs.push_back(sqrt(x * x + y * y));
+        phis.push_back(atan2(y, x));
+        zs.push_back(z);
+        layers.push_back(0); // layer is not stored in the input
+    }
+    completeEvent();
+    writer.close();
+
+    std::cout << "Converted " << eventsCount << " events from " << argv[1] << " to " << argv[2] << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -10,6 +10,7 @@ static constexpr bool DISPLAY_MEAN_STDEV    = 0;
 static constexpr bool DISPLAY_N_WEDGE       = 0;
 static constexpr bool DISPLAY_R_Z           = 0;
 static constexpr bool DISPLAY_R2            = 0;
+static constexpr bool DISPLAY_FRONTIER      = 0;
 
 #define INFO(MSG) std::cout << " . " << MSG << std::endl;
 
@@ -41,6 +42,7 @@ static constexpr bool DISPLAY_R2            = 0;
 #ifdef USE_SYCL
 #define ASSURE_THAT(COND, MSG)
 #else
+#include <stdexcept>
 #define ASSURE_THAT(COND, MSG) { if ( COND == false ) { throw std::runtime_error(MSG); } }
 #endif
 
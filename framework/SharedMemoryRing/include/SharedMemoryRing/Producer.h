@@ -0,0 +1,41 @@
+#pragma once
+
+#include "SharedMemoryRing/Ring.h"
+#include "SharedMemoryRing/Slots.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SharedMemoryRing
+{
+struct Result
+{
+    uint32_t eventId;
+    bool overflow;
+    std::vector<Solution> solutions;
+};
+
+// Client of the solver service: events are written to the events ring and solutions read from the results ring,
+// both rings are created by the service. submit() and receive() can be called from different threads.
+class Producer
+{
+public:
+    Producer(const std::string& eventsRingName, const std::string& resultsRingName);
+
+    uint32_t getMaxPoints() const;
+    // blocks while the events ring is full, returns false when the ring is closed
+    bool submit(uint32_t eventId, uint32_t pointsCount, const float* rs, const float* phis, const float* zs, const uint8_t* layers);
+    // blocks until solutions of an event are available, they come in order of completion;
+    // nullopt when the service closed the results ring and all results are read
+    std::optional<Result> receive();
+    // stops the service once submitted events are processed
+    void close();
+
+private:
+    Ring events_;
+    Ring results_;
+    EventSlotLayout eventsLayout_;
+    ResultSlotLayout resultsLayout_;
+};
+} // namespace SharedMemoryRing
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "SharedMemoryRing/SharedMemory.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace SharedMemoryRing
+{
+constexpr char MAGIC[8] = {'H', 'X', 'R', 'I', 'N', 'G', '\0', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t SLOT_ALIGNMENT = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Ring indices are shared between processes");
+
+// Beginning of the shared memory, slots follow at getSlotsOffset()
+struct RingHeader
+{
+    // set last by the creator, rings are not attached to before they are initialised
+    std::atomic<uint32_t> ready;
+    char magic[8];
+    uint32_t version;
+    uint32_t slotsCount;
+    uint64_t slotSize;
+    // indices grow monotonically, slot of an index is index % slotsCount
+    alignas(64) std::atomic<uint64_t> writeIndex;
+    alignas(64) std::atomic<uint64_t> readIndex;
+    alignas(64) std::atomic<uint32_t> closed;
+};
+
+// Single producer single consumer ring of fixed size slots in shared memory, producer and consumer
+// can live in different processes. Slots are used in place: acquired, filled or read, then committed or released.
+class Ring
+{
+public:
+    // creates the ring, slotSize is rounded up to SLOT_ALIGNMENT
+    Ring(const std::string& name, uint32_t slotsCount, uint64_t slotSize);
+    // attaches to a ring created by another process
+    explicit Ring(const std::string& name);
+
+    uint32_t getSlotsCount() const;
+    uint64_t getSlotSize() const;
+
+    // producer side, nullptr when there is no free slot or the ring is closed
+    std::byte* tryAcquireWriteSlot();
+    // blocks until a slot is free, nullptr when the ring is closed
+    std::byte* acquireWriteSlot();
+    void commitWriteSlot();
+
+    // consumer side, nullptr when there is no written slot
+    const std::byte* tryAcquireReadSlot();
+    // blocks until a slot is written, nullptr when the ring is closed and all slots are read
+    const std::byte* acquireReadSlot();
+    void releaseReadSlot();
+
+    // no more slots can be written, slots already written can still be read
+    void close();
+    bool isClosed() const;
+    // closed and all slots are read
+    bool isDrained() const;
+
+private:
+    static uint64_t getSlotsOffset();
+    std::byte* getSlot(uint64_t index) const;
+
+    SharedMemory memory_;
+    RingHeader* header_ = nullptr;
+};
+} // namespace SharedMemoryRing
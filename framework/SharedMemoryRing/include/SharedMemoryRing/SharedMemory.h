@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace SharedMemoryRing
+{
+// Read-write mapping of a POSIX shared memory object, name must start with '/'
+class SharedMemory
+{
+public:
+    // creates the object, it is removed when the creating instance is destroyed
+    SharedMemory(const std::string& name, size_t size);
+    // maps an object created by another process
+    explicit SharedMemory(const std::string& name);
+    SharedMemory(const SharedMemory&) = delete;
+    ~SharedMemory();
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    std::byte* getData() const;
+    size_t getSize() const;
+
+private:
+    void map(int fd);
+
+    std::string name_;
+    bool owner_ = false;
+    std::byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+} // namespace SharedMemoryRing
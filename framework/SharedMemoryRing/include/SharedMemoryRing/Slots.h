@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+
+// Slots of the rings used by the solver service, all values in native byte order.
+// Events ring slot: EventSlotHeader, then from SLOT_COLUMNS_OFFSET r[maxPoints], phi[maxPoints], z[maxPoints] as float
+// and layer[maxPoints] as uint8_t, the same columns as consumed by the solver; columns are filled up to pointsCount.
+// Results ring slot: ResultSlotHeader, then from SLOT_COLUMNS_OFFSET Solution[maxSolutions].
+// Capacities follow from the slot size of the ring, so both sides agree on them.
+namespace SharedMemoryRing
+{
+constexpr uint64_t SLOT_COLUMNS_OFFSET = 64;
+
+struct EventSlotHeader
+{
+    uint32_t eventId;
+    uint32_t pointsCount;
+};
+
+struct ResultSlotHeader
+{
+    uint32_t eventId;
+    uint32_t solutionsCount;
+    // set when the event had more solutions than fit in the slot
+    uint32_t overflow;
+};
+
+struct Solution
+{
+    float pt;
+    float phi;
+    float eta;
+    float z;
+    float d0;
+    int32_t nhits;
+    float q;
+};
+
+struct EventSlotLayout
+{
+    explicit EventSlotLayout(uint64_t slotSize)
+        : maxPoints((slotSize - SLOT_COLUMNS_OFFSET) / (3 * sizeof(float) + sizeof(uint8_t))),
+          rsOffset(SLOT_COLUMNS_OFFSET),
+          phisOffset(rsOffset + maxPoints * sizeof(float)),
+          zsOffset(phisOffset + maxPoints * sizeof(float)),
+          layersOffset(zsOffset + maxPoints * sizeof(float))
+    {
+    }
+
+    static uint64_t getSlotSize(uint32_t maxPoints)
+    {
+        return SLOT_COLUMNS_OFFSET + maxPoints * (3 * sizeof(float) + sizeof(uint8_t));
+    }
+
+    uint32_t maxPoints;
+    uint64_t rsOffset;
+    uint64_t phisOffset;
+    uint64_t zsOffset;
+    uint64_t layersOffset;
+};
+
+struct ResultSlotLayout
+{
+    explicit ResultSlotLayout(uint64_t slotSize)
+        : maxSolutions((slotSize - SLOT_COLUMNS_OFFSET) / sizeof(Solution)),
+          solutionsOffset(SLOT_COLUMNS_OFFSET)
+    {
+    }
+
+    static uint64_t getSlotSize(uint32_t maxSolutions)
+    {
+        return SLOT_COLUMNS_OFFSET + maxSolutions * sizeof(Solution);
+    }
+
+    uint32_t maxSolutions;
+    uint64_t solutionsOffset;
+};
+} // namespace SharedMemoryRing
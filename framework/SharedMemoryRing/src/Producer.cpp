@@ -0,0 +1,62 @@
+#include "SharedMemoryRing/Producer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace SharedMemoryRing
+{
+Producer::Producer(const std::string& eventsRingName, const std::string& resultsRingName)
+    : events_(eventsRingName),
+      results_(resultsRingName),
+      eventsLayout_(events_.getSlotSize()),
+      resultsLayout_(results_.getSlotSize())
+{
+}
+
+uint32_t Producer::getMaxPoints() const
+{
+    return eventsLayout_.maxPoints;
+}
+
+bool Producer::submit(uint32_t eventId, uint32_t pointsCount, const float* rs, const float* phis, const float* zs, const uint8_t* layers)
+{
+    if (pointsCount > eventsLayout_.maxPoints)
+    {
+        throw std::invalid_argument("Event " + std::to_string(eventId) + " has more points than fit in a slot");
+    }
+
+    std::byte* slot = events_.acquireWriteSlot();
+    if (slot == nullptr)
+    {
+        return false;
+    }
+    *reinterpret_cast<EventSlotHeader*>(slot) = EventSlotHeader{eventId, pointsCount};
+    std::copy(rs, rs + pointsCount, reinterpret_cast<float*>(slot + eventsLayout_.rsOffset));
+    std::copy(phis, phis + pointsCount, reinterpret_cast<float*>(slot + eventsLayout_.phisOffset));
+    std::copy(zs, zs + pointsCount, reinterpret_cast<float*>(slot + eventsLayout_.zsOffset));
+    std::copy(layers, layers + pointsCount, reinterpret_cast<uint8_t*>(slot + eventsLayout_.layersOffset));
+    events_.commitWriteSlot();
+    return true;
+}
+
+std::optional<Result> Producer::receive()
+{
+    const std::byte* slot = results_.acquireReadSlot();
+    if (slot == nullptr)
+    {
+        return std::nullopt;
+    }
+    const ResultSlotHeader& header = *reinterpret_cast<const ResultSlotHeader*>(slot);
+    const Solution* solutions = reinterpret_cast<const Solution*>(slot + resultsLayout_.solutionsOffset);
+    const uint32_t solutionsCount = std::min(header.solutionsCount, resultsLayout_.maxSolutions);
+
+    Result result{header.eventId, header.overflow != 0, std::vector<Solution>(solutions, solutions + solutionsCount)};
+    results_.releaseReadSlot();
+    return result;
+}
+
+void Producer::close()
+{
+    events_.close();
+}
+} // namespace SharedMemoryRing
@@ -0,0 +1,169 @@
+#include "SharedMemoryRing/Ring.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+namespace SharedMemoryRing
+{
+namespace
+{
+// waiting side spins first, then sleeps, so that an idle peer does not take a whole core
+constexpr uint32_t SPINS_BEFORE_SLEEP = 1024;
+constexpr std::chrono::microseconds SLEEP_INTERVAL(50);
+
+uint64_t alignSlotSize(uint64_t size)
+{
+    return (size + SLOT_ALIGNMENT - 1) / SLOT_ALIGNMENT * SLOT_ALIGNMENT;
+}
+
+void backOff(uint32_t& spins)
+{
+    if (spins < SPINS_BEFORE_SLEEP)
+    {
+        ++spins;
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(SLEEP_INTERVAL);
+}
+} // namespace
+
+Ring::Ring(const std::string& name, uint32_t slotsCount, uint64_t slotSize)
+    : memory_(name, getSlotsOffset() + slotsCount * alignSlotSize(slotSize))
+{
+    if (slotsCount == 0)
+    {
+        throw std::invalid_argument("Ring needs at least one slot: " + name);
+    }
+
+    header_ = new (memory_.getData()) RingHeader{};
+    header_->version = VERSION;
+    header_->slotsCount = slotsCount;
+    header_->slotSize = alignSlotSize(slotSize);
+    std::memcpy(header_->magic, MAGIC, sizeof(MAGIC));
+    header_->ready.store(1, std::memory_order_release);
+}
+
+Ring::Ring(const std::string& name)
+    : memory_(name)
+{
+    header_ = reinterpret_cast<RingHeader*>(memory_.getData());
+    if (memory_.getSize() < getSlotsOffset() || header_->ready.load(std::memory_order_acquire) == 0)
+    {
+        throw std::runtime_error("Ring is not initialised: " + name);
+    }
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version != VERSION)
+    {
+        throw std::runtime_error("Not a ring or unsupported version: " + name);
+    }
+    if (getSlotsOffset() + header_->slotsCount * header_->slotSize > memory_.getSize())
+    {
+        throw std::runtime_error("Corrupted ring: " + name);
+    }
+}
+
+uint32_t Ring::getSlotsCount() const
+{
+    return header_->slotsCount;
+}
+
+uint64_t Ring::getSlotSize() const
+{
+    return header_->slotSize;
+}
+
+std::byte* Ring::tryAcquireWriteSlot()
+{
+    if (isClosed())
+    {
+        return nullptr;
+    }
+    const uint64_t writeIndex = header_->writeIndex.load(std::memory_order_relaxed);
+    if (writeIndex - header_->readIndex.load(std::memory_order_acquire) == header_->slotsCount)
+    {
+        return nullptr;
+    }
+    return getSlot(writeIndex);
+}
+
+std::byte* Ring::acquireWriteSlot()
+{
+    uint32_t spins = 0;
+    while (!isClosed())
+    {
+        if (std::byte* slot = tryAcquireWriteSlot())
+        {
+            return slot;
+        }
+        backOff(spins);
+    }
+    return nullptr;
+}
+
+void Ring::commitWriteSlot()
+{
+    header_->writeIndex.fetch_add(1, std::memory_order_release);
+}
+
+const std::byte* Ring::tryAcquireReadSlot()
+{
+    const uint64_t readIndex = header_->readIndex.load(std::memory_order_relaxed);
+    if (header_->writeIndex.load(std::memory_order_acquire) == readIndex)
+    {
+        return nullptr;
+    }
+    return getSlot(readIndex);
+}
+
+const std::byte* Ring::acquireReadSlot()
+{
+    uint32_t spins = 0;
+    while (true)
+    {
+        // closed is checked first, slots written before closing are still returned
+        const bool closed = isClosed();
+        if (const std::byte* slot = tryAcquireReadSlot())
+        {
+            return slot;
+        }
+        if (closed)
+        {
+            return nullptr;
+        }
+        backOff(spins);
+    }
+}
+
+void Ring::releaseReadSlot()
+{
+    header_->readIndex.fetch_add(1, std::memory_order_release);
+}
+
+void Ring::close()
+{
+    header_->closed.store(1, std::memory_order_release);
+}
+
+bool Ring::isClosed() const
+{
+    return header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+bool Ring::isDrained() const
+{
+    return isClosed() && header_->writeIndex.load(std::memory_order_acquire) == header_->readIndex.load(std::memory_order_acquire);
+}
+
+uint64_t Ring::getSlotsOffset()
+{
+    return alignSlotSize(sizeof(RingHeader));
+}
+
+std::byte* Ring::getSlot(uint64_t index) const
+{
+    return memory_.getData() + getSlotsOffset() + (index % header_->slotsCount) * header_->slotSize;
+}
+} // namespace SharedMemoryRing
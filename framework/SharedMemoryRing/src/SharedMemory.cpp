@@ -0,0 +1,83 @@
+#include "SharedMemoryRing/SharedMemory.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SharedMemoryRing
+{
+SharedMemory::SharedMemory(const std::string& name, size_t size)
+    : name_(name), owner_(true), size_(size)
+{
+    // object left by a process which did not exit cleanly is replaced
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Can't create shared memory: " + name);
+    }
+    if (ftruncate(fd, size_) != 0)
+    {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Can't resize shared memory: " + name);
+    }
+    map(fd);
+}
+
+SharedMemory::SharedMemory(const std::string& name)
+    : name_(name)
+{
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Can't open shared memory: " + name);
+    }
+
+    struct stat memoryStat;
+    if (fstat(fd, &memoryStat) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Can't access shared memory: " + name);
+    }
+    size_ = memoryStat.st_size;
+    map(fd);
+}
+
+SharedMemory::~SharedMemory()
+{
+    munmap(data_, size_);
+    if (owner_)
+    {
+        shm_unlink(name_.c_str());
+    }
+}
+
+std::byte* SharedMemory::getData() const
+{
+    return data_;
+}
+
+size_t SharedMemory::getSize() const
+{
+    return size_;
+}
+
+void SharedMemory::map(int fd)
+{
+    void* mapping = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        if (owner_)
+        {
+            shm_unlink(name_.c_str());
+        }
+        throw std::runtime_error("Can't map shared memory: " + name_);
+    }
+    data_ = static_cast<std::byte*>(mapping);
+}
+} // namespace SharedMemoryRing
@@ -0,0 +1,177 @@
+#include "SharedMemoryRing/Producer.h"
+#include "SharedMemoryRing/Ring.h"
+#include "SharedMemoryRing/Slots.h"
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class RingSuite : public ::testing::Test
+{
+protected:
+    RingSuite()
+        : eventsRingName_("/RingSuite_events_" + std::to_string(getpid())),
+          resultsRingName_("/RingSuite_results_" + std::to_string(getpid()))
+    {
+    }
+
+    const std::string eventsRingName_;
+    const std::string resultsRingName_;
+};
+
+TEST_F(RingSuite, SlotSizeIsAligned)
+{
+    SharedMemoryRing::Ring ring(eventsRingName_, 3, 10);
+
+    ASSERT_EQ(3, ring.getSlotsCount());
+    ASSERT_EQ(SharedMemoryRing::SLOT_ALIGNMENT, ring.getSlotSize());
+}
+
+TEST_F(RingSuite, AttachToExistingRing)
+{
+    SharedMemoryRing::Ring created(eventsRingName_, 2, 128);
+    SharedMemoryRing::Ring attached(eventsRingName_);
+
+    ASSERT_EQ(2, attached.getSlotsCount());
+    ASSERT_EQ(128, attached.getSlotSize());
+
+    std::byte* slot = created.tryAcquireWriteSlot();
+    ASSERT_NE(nullptr, slot);
+    *reinterpret_cast<uint32_t*>(slot) = 42;
+    created.commitWriteSlot();
+
+    const std::byte* readSlot = attached.tryAcquireReadSlot();
+    ASSERT_NE(nullptr, readSlot);
+    ASSERT_EQ(42, *reinterpret_cast<const uint32_t*>(readSlot));
+    attached.releaseReadSlot();
+    ASSERT_EQ(nullptr, attached.tryAcquireReadSlot());
+}
+
+TEST_F(RingSuite, AttachToMissingRingThrows)
+{
+    ASSERT_THROW(SharedMemoryRing::Ring ring(eventsRingName_), std::runtime_error);
+}
+
+TEST_F(RingSuite, FullRingHasNoWriteSlot)
+{
+    SharedMemoryRing::Ring ring(eventsRingName_, 2, 64);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_NE(nullptr, ring.tryAcquireWriteSlot());
+        ring.commitWriteSlot();
+    }
+    ASSERT_EQ(nullptr, ring.tryAcquireWriteSlot());
+
+    ASSERT_NE(nullptr, ring.tryAcquireReadSlot());
+    ring.releaseReadSlot();
+    ASSERT_NE(nullptr, ring.tryAcquireWriteSlot());
+}
+
+TEST_F(RingSuite, ClosedRingIsDrainedAfterReading)
+{
+    SharedMemoryRing::Ring ring(eventsRingName_, 2, 64);
+    ring.acquireWriteSlot();
+    ring.commitWriteSlot();
+    ring.close();
+
+    ASSERT_EQ(nullptr, ring.acquireWriteSlot());
+    ASSERT_FALSE(ring.isDrained());
+    ASSERT_NE(nullptr, ring.acquireReadSlot());
+    ring.releaseReadSlot();
+    ASSERT_TRUE(ring.isDrained());
+    ASSERT_EQ(nullptr, ring.acquireReadSlot());
+}
+
+TEST_F(RingSuite, SlotsAreReadInOrderOfWriting)
+{
+    constexpr uint32_t valuesCount = 100000;
+    SharedMemoryRing::Ring producerRing(eventsRingName_, 4, 64);
+    SharedMemoryRing::Ring consumerRing(eventsRingName_);
+
+    std::thread producer([&producerRing]()
+    {
+        for (uint32_t i = 0; i < valuesCount; ++i)
+        {
+            std::byte* slot = producerRing.acquireWriteSlot();
+            std::memcpy(slot, &i, sizeof(i));
+            producerRing.commitWriteSlot();
+        }
+        producerRing.close();
+    });
+
+    uint32_t expected = 0;
+    while (const std::byte* slot = consumerRing.acquireReadSlot())
+    {
+        uint32_t value;
+        std::memcpy(&value, slot, sizeof(value));
+        ASSERT_EQ(expected, value);
+        ++expected;
+        consumerRing.releaseReadSlot();
+    }
+    producer.join();
+    ASSERT_EQ(valuesCount, expected);
+}
+
+TEST_F(RingSuite, ProducerRoundTrip)
+{
+    SharedMemoryRing::Ring events(eventsRingName_, 2, SharedMemoryRing::EventSlotLayout::getSlotSize(8));
+    SharedMemoryRing::Ring results(resultsRingName_, 2, SharedMemoryRing::ResultSlotLayout::getSlotSize(2));
+
+    // service answers every event with one solution per point, at most two of them fit in a slot
+    std::thread service([&events, &results]()
+    {
+        const SharedMemoryRing::EventSlotLayout eventsLayout(events.getSlotSize());
+        const SharedMemoryRing::ResultSlotLayout resultsLayout(results.getSlotSize());
+        while (const std::byte* eventSlot = events.acquireReadSlot())
+        {
+            const SharedMemoryRing::EventSlotHeader header = *reinterpret_cast<const SharedMemoryRing::EventSlotHeader*>(eventSlot);
+            const float* rs = reinterpret_cast<const float*>(eventSlot + eventsLayout.rsOffset);
+            std::byte* resultSlot = results.acquireWriteSlot();
+            const uint32_t solutionsCount = std::min(header.pointsCount, resultsLayout.maxSolutions);
+            *reinterpret_cast<SharedMemoryRing::ResultSlotHeader*>(resultSlot) = SharedMemoryRing::ResultSlotHeader{header.eventId, solutionsCount, header.pointsCount > solutionsCount};
+            auto* solutions = reinterpret_cast<SharedMemoryRing::Solution*>(resultSlot + resultsLayout.solutionsOffset);
+            for (uint32_t i = 0; i < solutionsCount; ++i)
+            {
+                solutions[i] = SharedMemoryRing::Solution{rs[i], 0, 0, 0, 0, 1, 1};
+            }
+            results.commitWriteSlot();
+            events.releaseReadSlot();
+        }
+        results.close();
+    });
+
+    SharedMemoryRing::Producer producer(eventsRingName_, resultsRingName_);
+    // slot is aligned, so that some more points fit in
+    ASSERT_LE(8, producer.getMaxPoints());
+    const std::vector<float> rs{1.0f, 2.0f, 3.0f};
+    const std::vector<float> phis{0.1f, 0.2f, 0.3f};
+    const std::vector<float> zs{-1.0f, 0.0f, 1.0f};
+    const std::vector<uint8_t> layers{1, 2, 3};
+    ASSERT_TRUE(producer.submit(7, 1, rs.data(), phis.data(), zs.data(), layers.data()));
+    ASSERT_TRUE(producer.submit(9, 3, rs.data(), phis.data(), zs.data(), layers.data()));
+    ASSERT_THROW(producer.submit(11, 1000, rs.data(), phis.data(), zs.data(), layers.data()), std::invalid_argument);
+    producer.close();
+
+    std::optional<SharedMemoryRing::Result> result = producer.receive();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(7, result->eventId);
+    ASSERT_FALSE(result->overflow);
+    ASSERT_EQ(1, result->solutions.size());
+    ASSERT_EQ(1.0f, result->solutions[0].pt);
+
+    result = producer.receive();
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(9, result->eventId);
+    ASSERT_TRUE(result->overflow);
+    ASSERT_EQ(2, result->solutions.size());
+    ASSERT_EQ(2.0f, result->solutions[1].pt);
+
+    ASSERT_FALSE(producer.receive().has_value());
+    service.join();
+}
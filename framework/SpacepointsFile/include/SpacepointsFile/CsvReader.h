@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SpacepointsFile
+{
+// Parses ACTS style per-event spacepoint CSV files (e.g. event000000042-spacepoint.csv). The first line names
+// the columns, x, y and z are taken by name and other columns are skipped.
+class CsvReader
+{
+public:
+    // columns are cleared and filled with cartesian coordinates, their capacity is reused between files
+    static void read(const std::string& path, std::vector<float>& xs, std::vector<float>& ys, std::vector<float>& zs);
+    // event id given by digits following "event" in the file name, std::nullopt if there are none
+    static std::optional<uint32_t> eventIdFromFileName(const std::string& fileName);
+};
+} // namespace SpacepointsFile
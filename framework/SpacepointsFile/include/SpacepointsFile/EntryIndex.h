@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace SpacepointsFile
+{
+// consecutive entries [begin, end) of one event in a spacepoints tree
+struct EntryRange
+{
+    uint32_t eventId;
+    int64_t begin;
+    int64_t end;
+};
+
+// Event id to entries index of a spacepoints tree. It is saved next to the input file (see getSidecarPath)
+// together with size and modification time of the input, an index of a modified input is not loaded.
+class EntryIndex
+{
+public:
+    // entries must be added in order
+    void addEntry(uint32_t eventId, int64_t entry);
+    const std::vector<EntryRange>& getRanges() const;
+    // entry ranges of the given events in order of entries, adjacent ranges are merged
+    std::vector<std::pair<int64_t, int64_t>> findEntries(const std::vector<uint32_t>& eventIds) const;
+    // entry ranges of events with ids from firstEventId to lastEventId (both included), merged the same way
+    std::vector<std::pair<int64_t, int64_t>> findEntriesInRange(uint32_t firstEventId, uint32_t lastEventId) const;
+
+    void save(const std::string& path, const std::string& sourcePath) const;
+    // nullopt when there is no index or it does not match the source file
+    static std::optional<EntryIndex> load(const std::string& path, const std::string& sourcePath);
+    static std::string getSidecarPath(const std::string& sourcePath);
+
+private:
+    std::vector<EntryRange> ranges_;
+};
+} // namespace SpacepointsFile
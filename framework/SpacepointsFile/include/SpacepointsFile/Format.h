@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Binary columnar spacepoints file, all values in native (little-endian) byte order:
+//   FileHeader
+//   event blocks, each aligned to BLOCK_ALIGNMENT: r[n], phi[n], z[n] as float, layer[n] as uint8_t
+//   EventIndexEntry[eventsCount] at header.indexOffset
+// Columns of an event can be used directly from a mapping of the file.
+namespace SpacepointsFile
+{
+constexpr char MAGIC[8] = {'H', 'X', 'S', 'P', 'C', 'O', 'L', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr uint64_t BLOCK_ALIGNMENT = 64;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t eventsCount;
+    uint64_t pointsCount;
+    uint64_t indexOffset;
+};
+
+struct EventIndexEntry
+{
+    uint32_t eventId;
+    uint32_t pointsCount;
+    // offset of the event block from the beginning of the file
+    uint64_t offset;
+};
+
+inline uint64_t alignBlockOffset(uint64_t offset)
+{
+    return (offset + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+}
+} // namespace SpacepointsFile
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace SpacepointsFile
+{
+// Read-only mapping of a whole file, empty files are not mapped
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    ~MappedFile();
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::byte* getData() const;
+    size_t getSize() const;
+
+private:
+    const std::byte* data_ = nullptr;
+    size_t size_ = 0;
+};
+} // namespace SpacepointsFile
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "SpacepointsFile/Format.h"
+#include "SpacepointsFile/MappedFile.h"
+
+#include <string>
+
+namespace SpacepointsFile
+{
+struct EventView
+{
+    uint32_t eventId;
+    uint32_t pointsCount;
+    const float* rs;
+    const float* phis;
+    const float* zs;
+    const uint8_t* layers;
+};
+
+// Maps the whole file read-only, views returned by getEvent are valid as long as the reader exists
+class MappedReader
+{
+public:
+    explicit MappedReader(const std::string& path);
+
+    uint32_t getEventsCount() const;
+    uint64_t getPointsCount() const;
+    EventView getEvent(uint32_t index) const;
+
+private:
+    MappedFile file_;
+    const FileHeader* header_ = nullptr;
+    const EventIndexEntry* index_ = nullptr;
+};
+} // namespace SpacepointsFile
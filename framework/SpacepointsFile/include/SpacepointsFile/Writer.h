@@ -0,0 +1,33 @@
+#pragma once
+
+#include "SpacepointsFile/Format.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace SpacepointsFile
+{
+// Writes events one after another, the index is written by close()
+class Writer
+{
+public:
+    explicit Writer(const std::string& path);
+    Writer(const Writer&) = delete;
+    // closes the file if close() was not called
+    ~Writer();
+    Writer& operator=(const Writer&) = delete;
+
+    // all columns must have the same size
+    void addEvent(uint32_t eventId, const std::vector<float>& rs, const std::vector<float>& phis, const std::vector<float>& zs, const std::vector<uint8_t>& layers);
+    void close();
+
+private:
+    void pad(uint64_t offset);
+
+    std::ofstream file_;
+    std::vector<EventIndexEntry> index_;
+    uint64_t offset_ = 0;
+    uint64_t pointsCount_ = 0;
+};
+} // namespace SpacepointsFile
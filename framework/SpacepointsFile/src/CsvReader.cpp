@@ -0,0 +1,118 @@
+#include "SpacepointsFile/CsvReader.h"
+#include "SpacepointsFile/MappedFile.h"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+
+namespace SpacepointsFile
+{
+namespace
+{
+bool isBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view trim(std::string_view field)
+{
+    while (!field.empty() && isBlank(field.front()))
+        field.remove_prefix(1);
+    while (!field.empty() && isBlank(field.back()))
+        field.remove_suffix(1);
+    return field;
+}
+
+// returns the field and moves line past the following comma
+std::string_view nextField(std::string_view& line)
+{
+    const size_t comma = line.find(',');
+    const std::string_view field = line.substr(0, comma);
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    return trim(field);
+}
+
+std::string_view nextLine(std::string_view& text)
+{
+    const size_t newline = text.find('\n');
+    const std::string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    return line;
+}
+} // namespace
+
+void CsvReader::read(const std::string& path, std::vector<float>& xs, std::vector<float>& ys, std::vector<float>& zs)
+{
+    xs.clear();
+    ys.clear();
+    zs.clear();
+
+    const MappedFile file(path);
+    std::string_view text(reinterpret_cast<const char*>(file.getData()), file.getSize());
+
+    constexpr uint32_t missing = UINT32_MAX;
+    uint32_t xColumn = missing;
+    uint32_t yColumn = missing;
+    uint32_t zColumn = missing;
+    uint32_t columnsCount = 0;
+    std::string_view header = nextLine(text);
+    while (!header.empty())
+    {
+        const std::string_view name = nextField(header);
+        if (name == "x") xColumn = columnsCount;
+        else if (name == "y") yColumn = columnsCount;
+        else if (name == "z") zColumn = columnsCount;
+        ++columnsCount;
+    }
+    if (xColumn == missing || yColumn == missing || zColumn == missing)
+    {
+        throw std::runtime_error("Columns x, y and z expected in the header of " + path);
+    }
+
+    // approximate, avoids reallocation for typical line lengths
+    xs.reserve(text.size() / (8 * columnsCount));
+    ys.reserve(text.size() / (8 * columnsCount));
+    zs.reserve(text.size() / (8 * columnsCount));
+
+    for (uint32_t lineNumber = 2; !text.empty(); ++lineNumber)
+    {
+        std::string_view line = nextLine(text);
+        if (trim(line).empty())
+            continue;
+
+        float x = 0;
+        float y = 0;
+        float z = 0;
+        for (uint32_t column = 0; column < columnsCount; ++column)
+        {
+            const std::string_view field = nextField(line);
+            float* value = column == xColumn ? &x : column == yColumn ? &y : column == zColumn ? &z : nullptr;
+            if (value == nullptr)
+                continue;
+
+            const std::from_chars_result result = std::from_chars(field.data(), field.data() + field.size(), *value);
+            if (result.ec != std::errc() || result.ptr != field.data() + field.size())
+            {
+                throw std::runtime_error("Can't parse value in line " + std::to_string(lineNumber) + " of " + path);
+            }
+        }
+        xs.push_back(x);
+        ys.push_back(y);
+        zs.push_back(z);
+    }
+}
+
+std::optional<uint32_t> CsvReader::eventIdFromFileName(const std::string& fileName)
+{
+    const size_t prefix = fileName.rfind("event");
+    if (prefix == std::string::npos)
+        return std::nullopt;
+
+    const char* begin = fileName.data() + prefix + std::string_view("event").size();
+    uint32_t eventId;
+    const std::from_chars_result result = std::from_chars(begin, fileName.data() + fileName.size(), eventId);
+    if (result.ec != std::errc() || result.ptr == begin)
+        return std::nullopt;
+    return eventId;
+}
+} // namespace SpacepointsFile
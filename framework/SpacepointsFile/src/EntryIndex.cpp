@@ -0,0 +1,147 @@
+#include "SpacepointsFile/EntryIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace SpacepointsFile
+{
+namespace
+{
+constexpr char INDEX_MAGIC[8] = {'H', 'X', 'E', 'V', 'I', 'D', 'X', '\0'};
+constexpr uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t rangesCount;
+    // identify the source file the index was built for
+    uint64_t sourceSize;
+    int64_t sourceModificationTime;
+};
+
+struct SourceStamp
+{
+    uint64_t size;
+    int64_t modificationTime;
+};
+
+SourceStamp stampSource(const std::string& sourcePath)
+{
+    return SourceStamp{
+        static_cast<uint64_t>(std::filesystem::file_size(sourcePath)),
+        static_cast<int64_t>(std::filesystem::last_write_time(sourcePath).time_since_epoch().count())};
+}
+
+template<typename Selects>
+std::vector<std::pair<int64_t, int64_t>> findSelectedEntries(const std::vector<EntryRange>& ranges, Selects selects)
+{
+    std::vector<std::pair<int64_t, int64_t>> entries;
+    for (const EntryRange& range : ranges)
+    {
+        if (!selects(range.eventId))
+        {
+            continue;
+        }
+        if (!entries.empty() && entries.back().second == range.begin)
+        {
+            entries.back().second = range.end;
+            continue;
+        }
+        entries.emplace_back(range.begin, range.end);
+    }
+    return entries;
+}
+} // namespace
+
+void EntryIndex::addEntry(uint32_t eventId, int64_t entry)
+{
+    if (!ranges_.empty() && ranges_.back().eventId == eventId && ranges_.back().end == entry)
+    {
+        ++ranges_.back().end;
+        return;
+    }
+    ranges_.push_back(EntryRange{eventId, entry, entry + 1});
+}
+
+const std::vector<EntryRange>& EntryIndex::getRanges() const
+{
+    return ranges_;
+}
+
+std::vector<std::pair<int64_t, int64_t>> EntryIndex::findEntries(const std::vector<uint32_t>& eventIds) const
+{
+    std::vector<uint32_t> sortedIds(eventIds);
+    std::sort(sortedIds.begin(), sortedIds.end());
+
+    return findSelectedEntries(ranges_, [&sortedIds](uint32_t eventId)
+    {
+        return std::binary_search(sortedIds.begin(), sortedIds.end(), eventId);
+    });
+}
+
+std::vector<std::pair<int64_t, int64_t>> EntryIndex::findEntriesInRange(uint32_t firstEventId, uint32_t lastEventId) const
+{
+    return findSelectedEntries(ranges_, [firstEventId, lastEventId](uint32_t eventId)
+    {
+        return firstEventId <= eventId && eventId <= lastEventId;
+    });
+}
+
+void EntryIndex::save(const std::string& path, const std::string& sourcePath) const
+{
+    const SourceStamp stamp = stampSource(sourcePath);
+    IndexHeader header{};
+    std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.rangesCount = ranges_.size();
+    header.sourceSize = stamp.size;
+    header.sourceModificationTime = stamp.modificationTime;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Can't open index file: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(ranges_.data()), ranges_.size() * sizeof(EntryRange));
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("Writing index file failed: " + path);
+    }
+}
+
+std::optional<EntryIndex> EntryIndex::load(const std::string& path, const std::string& sourcePath)
+{
+    std::ifstream file(path, std::ios::binary);
+    IndexHeader header{};
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        return std::nullopt;
+    }
+
+    const SourceStamp stamp = stampSource(sourcePath);
+    if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.version != INDEX_VERSION
+        || header.sourceSize != stamp.size || header.sourceModificationTime != stamp.modificationTime)
+    {
+        return std::nullopt;
+    }
+
+    EntryIndex index;
+    index.ranges_.resize(header.rangesCount);
+    if (!file.read(reinterpret_cast<char*>(index.ranges_.data()), index.ranges_.size() * sizeof(EntryRange)))
+    {
+        return std::nullopt;
+    }
+    return index;
+}
+
+std::string EntryIndex::getSidecarPath(const std::string& sourcePath)
+{
+    return sourcePath + ".idx";
+}
+} // namespace SpacepointsFile
@@ -0,0 +1,61 @@
+#include "SpacepointsFile/MappedFile.h"
+
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SpacepointsFile
+{
+MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Can't open input file: " + path);
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("Can't access input file: " + path);
+    }
+    size_ = fileStat.st_size;
+    if (size_ == 0)
+    {
+        ::close(fd);
+        return;
+    }
+
+    void* mapping = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("Can't map input file: " + path);
+    }
+    data_ = static_cast<const std::byte*>(mapping);
+    // files are usually read front to back
+    madvise(mapping, size_, MADV_SEQUENTIAL);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+const std::byte* MappedFile::getData() const
+{
+    return data_;
+}
+
+size_t MappedFile::getSize() const
+{
+    return size_;
+}
+} // namespace SpacepointsFile
@@ -0,0 +1,56 @@
+#include "SpacepointsFile/MappedReader.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace SpacepointsFile
+{
+MappedReader::MappedReader(const std::string& path)
+    : file_(path)
+{
+    if (file_.getSize() < sizeof(FileHeader))
+    {
+        throw std::runtime_error("Not a spacepoints file: " + path);
+    }
+
+    header_ = reinterpret_cast<const FileHeader*>(file_.getData());
+    if (std::memcmp(header_->magic, MAGIC, sizeof(MAGIC)) != 0 || header_->version != VERSION
+        || header_->indexOffset + header_->eventsCount * sizeof(EventIndexEntry) > file_.getSize())
+    {
+        throw std::runtime_error("Not a spacepoints file or unsupported version: " + path);
+    }
+    index_ = reinterpret_cast<const EventIndexEntry*>(file_.getData() + header_->indexOffset);
+
+    for (uint32_t i = 0; i < header_->eventsCount; ++i)
+    {
+        if (index_[i].offset + index_[i].pointsCount * (3 * sizeof(float) + sizeof(uint8_t)) > header_->indexOffset)
+        {
+            throw std::runtime_error("Corrupted spacepoints file: " + path);
+        }
+    }
+}
+
+uint32_t MappedReader::getEventsCount() const
+{
+    return header_->eventsCount;
+}
+
+uint64_t MappedReader::getPointsCount() const
+{
+    return header_->pointsCount;
+}
+
+EventView MappedReader::getEvent(uint32_t index) const
+{
+    const EventIndexEntry& entry = index_[index];
+    const float* rs = reinterpret_cast<const float*>(file_.getData() + entry.offset);
+
+    return EventView{
+        entry.eventId,
+        entry.pointsCount,
+        rs,
+        rs + entry.pointsCount,
+        rs + 2 * entry.pointsCount,
+        reinterpret_cast<const uint8_t*>(rs + 3 * entry.pointsCount)};
+}
+} // namespace SpacepointsFile
@@ -0,0 +1,76 @@
+#include "SpacepointsFile/Writer.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace SpacepointsFile
+{
+Writer::Writer(const std::string& path)
+    : file_(path, std::ios::binary | std::ios::trunc)
+{
+    if (!file_)
+    {
+        throw std::runtime_error("Can't open output file: " + path);
+    }
+
+    // header is rewritten by close() once counts and index offset are known
+    FileHeader header{};
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset_ = sizeof(header);
+}
+
+Writer::~Writer()
+{
+    if (file_.is_open())
+    {
+        close();
+    }
+}
+
+void Writer::addEvent(uint32_t eventId, const std::vector<float>& rs, const std::vector<float>& phis, const std::vector<float>& zs, const std::vector<uint8_t>& layers)
+{
+    if (phis.size() != rs.size() || zs.size() != rs.size() || layers.size() != rs.size())
+    {
+        throw std::invalid_argument("Columns of event " + std::to_string(eventId) + " differ in size");
+    }
+
+    pad(alignBlockOffset(offset_));
+    index_.push_back(EventIndexEntry{eventId, static_cast<uint32_t>(rs.size()), offset_});
+
+    file_.write(reinterpret_cast<const char*>(rs.data()), rs.size() * sizeof(float));
+    file_.write(reinterpret_cast<const char*>(phis.data()), phis.size() * sizeof(float));
+    file_.write(reinterpret_cast<const char*>(zs.data()), zs.size() * sizeof(float));
+    file_.write(reinterpret_cast<const char*>(layers.data()), layers.size() * sizeof(uint8_t));
+    offset_ += rs.size() * (3 * sizeof(float) + sizeof(uint8_t));
+    pointsCount_ += rs.size();
+}
+
+void Writer::close()
+{
+    pad(alignBlockOffset(offset_));
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.eventsCount = index_.size();
+    header.pointsCount = pointsCount_;
+    header.indexOffset = offset_;
+
+    file_.write(reinterpret_cast<const char*>(index_.data()), index_.size() * sizeof(EventIndexEntry));
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file_.close();
+
+    if (!file_)
+    {
+        throw std::runtime_error("Writing spacepoints file failed");
+    }
+}
+
+void Writer::pad(uint64_t offset)
+{
+    static const char zeros[BLOCK_ALIGNMENT] = {};
+    file_.write(zeros, offset - offset_);
+    offset_ = offset;
+}
+} // namespace SpacepointsFile
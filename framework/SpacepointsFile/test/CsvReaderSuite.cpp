@@ -0,0 +1,117 @@
+#include "SpacepointsFile/CsvReader.h"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class CsvReaderSuite : public ::testing::Test
+{
+protected:
+    CsvReaderSuite()
+    {
+        const char* sandboxDir = std::getenv("TEST_SANDBOX_DIR");
+        if (sandboxDir == nullptr)
+        {
+            throw std::runtime_error("Environment variable $TEST_SANDBOX_DIR not set");
+        }
+
+        filePath_ = std::string(sandboxDir) + "/CsvReaderSuite/event000000042-spacepoint.csv";
+
+        std::filesystem::path directoryPath{filePath_};
+        directoryPath.remove_filename();
+        if (!std::filesystem::exists(directoryPath))
+        {
+            std::filesystem::create_directories(directoryPath);
+        }
+    }
+
+    ~CsvReaderSuite()
+    {
+        std::filesystem::path directoryPath{filePath_};
+        directoryPath.remove_filename();
+        std::filesystem::remove_all(directoryPath);
+    }
+
+    void writeFile(const std::string& content)
+    {
+        std::ofstream file(filePath_);
+        file << content;
+    }
+
+    std::string filePath_;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<float> zs_;
+};
+
+TEST_F(CsvReaderSuite, ActsColumns)
+{
+    writeFile("measurement_id,geometry_id,x,y,z,var_r,var_z\n"
+              "0,936748859932016651,-29.5,12.25,-1500,0.001,0.002\n"
+              "1,936748859932016652,1e2,-2.5E-1,7,0,0\n");
+
+    SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_);
+
+    ASSERT_EQ((std::vector<float>{-29.5f, 1e2f}), xs_);
+    ASSERT_EQ((std::vector<float>{12.25f, -2.5e-1f}), ys_);
+    ASSERT_EQ((std::vector<float>{-1500.0f, 7.0f}), zs_);
+}
+
+TEST_F(CsvReaderSuite, SpacesCarriageReturnsAndEmptyLines)
+{
+    writeFile("x, y, z\r\n1.5, 2.5, 3.5\r\n\r\n4, 5, 6");
+
+    SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_);
+
+    ASSERT_EQ((std::vector<float>{1.5f, 4.0f}), xs_);
+    ASSERT_EQ((std::vector<float>{2.5f, 5.0f}), ys_);
+    ASSERT_EQ((std::vector<float>{3.5f, 6.0f}), zs_);
+}
+
+TEST_F(CsvReaderSuite, ColumnsAreCleared)
+{
+    writeFile("x,y,z\n1,2,3\n");
+    xs_ = {9.0f};
+    ys_ = {9.0f};
+    zs_ = {9.0f};
+
+    SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_);
+
+    ASSERT_EQ(1, xs_.size());
+    ASSERT_EQ(1, ys_.size());
+    ASSERT_EQ(1, zs_.size());
+}
+
+TEST_F(CsvReaderSuite, HeaderOnly)
+{
+    writeFile("x,y,z\n");
+
+    SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_);
+
+    ASSERT_TRUE(xs_.empty());
+}
+
+TEST_F(CsvReaderSuite, MissingColumn)
+{
+    writeFile("x,y\n1,2\n");
+
+    ASSERT_THROW(SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_), std::runtime_error);
+}
+
+TEST_F(CsvReaderSuite, BadValue)
+{
+    writeFile("x,y,z\n1,two,3\n");
+
+    ASSERT_THROW(SpacepointsFile::CsvReader::read(filePath_, xs_, ys_, zs_), std::runtime_error);
+}
+
+TEST_F(CsvReaderSuite, EventIdFromFileName)
+{
+    ASSERT_EQ(42, SpacepointsFile::CsvReader::eventIdFromFileName("event000000042-spacepoint.csv"));
+    ASSERT_EQ(7, SpacepointsFile::CsvReader::eventIdFromFileName("/data/run/event7-spacepoint.csv"));
+    ASSERT_EQ(std::nullopt, SpacepointsFile::CsvReader::eventIdFromFileName("spacepoint.csv"));
+    ASSERT_EQ(std::nullopt, SpacepointsFile::CsvReader::eventIdFromFileName("event-spacepoint.csv"));
+}
@@ -0,0 +1,127 @@
+#include "SpacepointsFile/EntryIndex.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+class EntryIndexSuite : public ::testing::Test
+{
+protected:
+    EntryIndexSuite()
+    {
+        const char* sandboxDir = std::getenv("TEST_SANDBOX_DIR");
+        if (sandboxDir == nullptr)
+        {
+            throw std::runtime_error("Environment variable $TEST_SANDBOX_DIR not set");
+        }
+
+        sourcePath_ = std::string(sandboxDir) + "/EntryIndexSuite/spacepoints.root";
+        indexPath_ = SpacepointsFile::EntryIndex::getSidecarPath(sourcePath_);
+
+        std::filesystem::path directoryPath{sourcePath_};
+        directoryPath.remove_filename();
+        if (!std::filesystem::exists(directoryPath))
+        {
+            std::filesystem::create_directories(directoryPath);
+        }
+        std::ofstream(sourcePath_) << "source";
+    }
+
+    ~EntryIndexSuite()
+    {
+        std::filesystem::path directoryPath{sourcePath_};
+        directoryPath.remove_filename();
+        std::filesystem::remove_all(directoryPath);
+    }
+
+    static SpacepointsFile::EntryIndex buildIndex()
+    {
+        SpacepointsFile::EntryIndex index;
+        const std::vector<uint32_t> eventIds{3, 3, 3, 5, 5, 8, 3, 9, 9};
+        for (int64_t entry = 0; entry < static_cast<int64_t>(eventIds.size()); ++entry)
+        {
+            index.addEntry(eventIds[entry], entry);
+        }
+        return index;
+    }
+
+    std::string sourcePath_;
+    std::string indexPath_;
+};
+
+TEST_F(EntryIndexSuite, ConsecutiveEntriesFormRanges)
+{
+    const SpacepointsFile::EntryIndex index = buildIndex();
+
+    const std::vector<SpacepointsFile::EntryRange>& ranges = index.getRanges();
+    ASSERT_EQ(5, ranges.size());
+    ASSERT_EQ(3, ranges[0].eventId);
+    ASSERT_EQ(0, ranges[0].begin);
+    ASSERT_EQ(3, ranges[0].end);
+    ASSERT_EQ(5, ranges[1].eventId);
+    ASSERT_EQ(3, ranges[1].begin);
+    ASSERT_EQ(5, ranges[1].end);
+    ASSERT_EQ(3, ranges[3].eventId);
+    ASSERT_EQ(6, ranges[3].begin);
+    ASSERT_EQ(7, ranges[3].end);
+}
+
+TEST_F(EntryIndexSuite, FindEntries)
+{
+    const SpacepointsFile::EntryIndex index = buildIndex();
+
+    using Entries = std::vector<std::pair<int64_t, int64_t>>;
+    ASSERT_EQ((Entries{{3, 5}}), index.findEntries({5}));
+    ASSERT_EQ((Entries{{0, 3}, {6, 7}}), index.findEntries({3}));
+    ASSERT_EQ((Entries{{0, 3}, {6, 9}}), index.findEntries({9, 3}));
+    // adjacent ranges of different events are merged
+    ASSERT_EQ((Entries{{3, 6}}), index.findEntries({5, 8}));
+    ASSERT_EQ((Entries{{0, 7}}), index.findEntries({8, 5, 3, 4}));
+    ASSERT_TRUE(index.findEntries({1, 2}).empty());
+}
+
+TEST_F(EntryIndexSuite, FindEntriesInRange)
+{
+    const SpacepointsFile::EntryIndex index = buildIndex();
+
+    using Entries = std::vector<std::pair<int64_t, int64_t>>;
+    ASSERT_EQ((Entries{{3, 6}}), index.findEntriesInRange(4, 8));
+    ASSERT_EQ((Entries{{0, 7}}), index.findEntriesInRange(3, 8));
+    // the last id is included, even the largest one
+    ASSERT_EQ((Entries{{5, 6}, {7, 9}}), index.findEntriesInRange(8, UINT32_MAX));
+    ASSERT_TRUE(index.findEntriesInRange(10, UINT32_MAX).empty());
+}
+
+TEST_F(EntryIndexSuite, SaveAndLoad)
+{
+    const SpacepointsFile::EntryIndex index = buildIndex();
+    index.save(indexPath_, sourcePath_);
+
+    const std::optional<SpacepointsFile::EntryIndex> loaded = SpacepointsFile::EntryIndex::load(indexPath_, sourcePath_);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(index.getRanges().size(), loaded->getRanges().size());
+    for (size_t i = 0; i < index.getRanges().size(); ++i)
+    {
+        ASSERT_EQ(index.getRanges()[i].eventId, loaded->getRanges()[i].eventId);
+        ASSERT_EQ(index.getRanges()[i].begin, loaded->getRanges()[i].begin);
+        ASSERT_EQ(index.getRanges()[i].end, loaded->getRanges()[i].end);
+    }
+}
+
+TEST_F(EntryIndexSuite, MissingIndexIsNotLoaded)
+{
+    ASSERT_FALSE(SpacepointsFile::EntryIndex::load(indexPath_, sourcePath_).has_value());
+}
+
+TEST_F(EntryIndexSuite, IndexOfModifiedSourceIsNotLoaded)
+{
+    buildIndex().save(indexPath_, sourcePath_);
+    std::ofstream(sourcePath_, std::ios::app) << " modified";
+
+    ASSERT_FALSE(SpacepointsFile::EntryIndex::load(indexPath_, sourcePath_).has_value());
+}
@@ -0,0 +1,116 @@
+#include "SpacepointsFile/MappedReader.h"
+#include "SpacepointsFile/Writer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class SpacepointsFileSuite : public ::testing::Test
+{
+protected:
+    SpacepointsFileSuite()
+    {
+        const char* sandboxDir = std::getenv("TEST_SANDBOX_DIR");
+        if (sandboxDir == nullptr)
+        {
+            throw std::runtime_error("Environment variable $TEST_SANDBOX_DIR not set");
+        }
+
+        filePath_ = std::string(sandboxDir) + "/SpacepointsFileSuite/spacepoints.bin";
+
+        std::filesystem::path directoryPath{filePath_};
+        directoryPath.remove_filename();
+        if (!std::filesystem::exists(directoryPath))
+        {
+            std::filesystem::create_directories(directoryPath);
+        }
+    }
+
+    ~SpacepointsFileSuite()
+    {
+        std::filesystem::path directoryPath{filePath_};
+        directoryPath.remove_filename();
+        std::filesystem::remove_all(directoryPath);
+    }
+
+    std::string filePath_;
+};
+
+TEST_F(SpacepointsFileSuite, WriteAndRead)
+{
+    const std::vector<float> rs{1.0f, 2.0f, 3.0f};
+    const std::vector<float> phis{0.1f, 0.2f, 0.3f};
+    const std::vector<float> zs{-1.0f, 0.0f, 1.0f};
+    const std::vector<uint8_t> layers{1, 2, 3};
+    {
+        SpacepointsFile::Writer writer(filePath_);
+        writer.addEvent(7, rs, phis, zs, layers);
+        writer.addEvent(9, {}, {}, {}, {});
+        writer.addEvent(11, {4.0f}, {0.4f}, {4.0f}, {4});
+        writer.close();
+    }
+
+    const SpacepointsFile::MappedReader reader(filePath_);
+    ASSERT_EQ(3, reader.getEventsCount());
+    ASSERT_EQ(4, reader.getPointsCount());
+
+    const SpacepointsFile::EventView first = reader.getEvent(0);
+    ASSERT_EQ(7, first.eventId);
+    ASSERT_EQ(3, first.pointsCount);
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(first.rs) % SpacepointsFile::BLOCK_ALIGNMENT);
+    for (uint32_t i = 0; i < first.pointsCount; ++i)
+    {
+        ASSERT_EQ(rs[i], first.rs[i]);
+        ASSERT_EQ(phis[i], first.phis[i]);
+        ASSERT_EQ(zs[i], first.zs[i]);
+        ASSERT_EQ(layers[i], first.layers[i]);
+    }
+
+    const SpacepointsFile::EventView empty = reader.getEvent(1);
+    ASSERT_EQ(9, empty.eventId);
+    ASSERT_EQ(0, empty.pointsCount);
+
+    const SpacepointsFile::EventView last = reader.getEvent(2);
+    ASSERT_EQ(11, last.eventId);
+    ASSERT_EQ(1, last.pointsCount);
+    ASSERT_EQ(4.0f, last.rs[0]);
+    ASSERT_EQ(0.4f, last.phis[0]);
+    ASSERT_EQ(4.0f, last.zs[0]);
+    ASSERT_EQ(4, last.layers[0]);
+}
+
+TEST_F(SpacepointsFileSuite, WriterClosesOnDestruction)
+{
+    {
+        SpacepointsFile::Writer writer(filePath_);
+        writer.addEvent(1, {1.0f}, {0.1f}, {1.0f}, {0});
+    }
+
+    const SpacepointsFile::MappedReader reader(filePath_);
+    ASSERT_EQ(1, reader.getEventsCount());
+}
+
+TEST_F(SpacepointsFileSuite, ColumnsOfDifferentSize)
+{
+    SpacepointsFile::Writer writer(filePath_);
+
+    ASSERT_THROW(writer.addEvent(1, {1.0f, 2.0f}, {0.1f}, {1.0f}, {0}), std::invalid_argument);
+}
+
+TEST_F(SpacepointsFileSuite, NotASpacepointsFile)
+{
+    std::ofstream file(filePath_);
+    file << "definitely not a spacepoints file, but long enough to contain a header";
+    file.close();
+
+    ASSERT_THROW(SpacepointsFile::MappedReader reader(filePath_), std::runtime_error);
+}
+
+TEST_F(SpacepointsFileSuite, MissingFile)
+{
+    ASSERT_THROW(SpacepointsFile::MappedReader reader(filePath_ + ".missing"), std::runtime_error);
+}
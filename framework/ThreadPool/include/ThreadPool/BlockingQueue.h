@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace ThreadPool
+{
+// Bounded multi-producer multi-consumer queue. Producers block while the queue is full, consumers block
+// while it is empty. After close() producers are rejected and consumers drain the remaining elements.
+template<typename T>
+class BlockingQueue
+{
+public:
+    explicit BlockingQueue(uint32_t capacity);
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    // returns false if the queue was closed, the element is dropped then
+    bool push(T&& element);
+    // returns std::nullopt once the queue is closed and empty
+    std::optional<T> pop();
+    void close();
+
+    uint32_t getCapacity() const;
+
+private:
+    const uint32_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> elements_;
+    bool closed_ = false;
+};
+
+template<typename T>
+BlockingQueue<T>::BlockingQueue(uint32_t capacity)
+    : capacity_(capacity > 0 ? capacity : 1) {}
+
+template<typename T>
+bool BlockingQueue<T>::push(T&& element)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this](){ return closed_ || elements_.size() < capacity_; });
+        if (closed_) return false;
+
+        elements_.push_back(std::move(element));
+    }
+    notEmpty_.notify_one();
+    return true;
+}
+
+template<typename T>
+std::optional<T> BlockingQueue<T>::pop()
+{
+    std::optional<T> element;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this](){ return closed_ || !elements_.empty(); });
+        if (elements_.empty()) return std::nullopt;
+
+        element.emplace(std::move(elements_.front()));
+        elements_.pop_front();
+    }
+    notFull_.notify_one();
+    return element;
+}
+
+template<typename T>
+void BlockingQueue<T>::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    notFull_.notify_all();
+    notEmpty_.notify_all();
+}
+
+template<typename T>
+uint32_t BlockingQueue<T>::getCapacity() const
+{
+    return capacity_;
+}
+} // namespace ThreadPool
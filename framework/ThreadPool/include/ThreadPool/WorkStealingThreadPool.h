@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ThreadPool
+{
+// Each thread owns a deque of tasks. Tasks submitted from a pool thread go to its own deque and are
+// taken LIFO, idle threads steal the oldest tasks from the other deques. Tasks submitted from outside
+// of the pool are distributed round robin. Tasks must not throw.
+class WorkStealingThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // threadsCount equal to 0 means one thread per hardware thread
+    explicit WorkStealingThreadPool(uint32_t threadsCount = 0);
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    // runs all already submitted tasks before joining threads
+    ~WorkStealingThreadPool();
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+    void submit(Task task);
+    uint32_t getThreadsCount() const;
+
+private:
+    struct TaskDeque
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(uint32_t threadIndex);
+    bool popOwn(uint32_t threadIndex, Task& task);
+    bool steal(uint32_t threadIndex, Task& task);
+
+    std::vector<std::unique_ptr<TaskDeque>> deques_;
+    std::vector<std::thread> threads_;
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    // guarded by sleepMutex_, counted before a task is pushed so that it never goes below zero
+    uint32_t queuedTasks_ = 0;
+    bool stopping_ = false;
+    uint32_t nextDeque_ = 0;
+
+    static thread_local WorkStealingThreadPool* currentPool_;
+    static thread_local uint32_t currentThreadIndex_;
+};
+} // namespace ThreadPool
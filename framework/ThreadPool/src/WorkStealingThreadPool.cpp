@@ -0,0 +1,112 @@
+#include "ThreadPool/WorkStealingThreadPool.h"
+
+#include <algorithm>
+
+namespace ThreadPool
+{
+thread_local WorkStealingThreadPool* WorkStealingThreadPool::currentPool_ = nullptr;
+thread_local uint32_t WorkStealingThreadPool::currentThreadIndex_ = 0;
+
+WorkStealingThreadPool::WorkStealingThreadPool(uint32_t threadsCount)
+{
+    if (threadsCount == 0)
+    {
+        threadsCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (uint32_t i = 0; i < threadsCount; ++i)
+    {
+        deques_.push_back(std::make_unique<TaskDeque>());
+    }
+    for (uint32_t i = 0; i < threadsCount; ++i)
+    {
+        threads_.emplace_back(&WorkStealingThreadPool::run, this, i);
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+
+    for (std::thread& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingThreadPool::submit(Task task)
+{
+    uint32_t dequeIndex;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++queuedTasks_;
+        dequeIndex = currentPool_ == this ? currentThreadIndex_ : nextDeque_++ % deques_.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(deques_[dequeIndex]->mutex);
+        deques_[dequeIndex]->tasks.push_back(std::move(task));
+    }
+    sleepCondition_.notify_one();
+}
+
+uint32_t WorkStealingThreadPool::getThreadsCount() const
+{
+    return threads_.size();
+}
+
+void WorkStealingThreadPool::run(uint32_t threadIndex)
+{
+    currentPool_ = this;
+    currentThreadIndex_ = threadIndex;
+
+    while (true)
+    {
+        Task task;
+        if (popOwn(threadIndex, task) || steal(threadIndex, task))
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                --queuedTasks_;
+            }
+            task();
+            continue;
+        }
+
+        // a task may be counted but not pushed yet, in such case the thread checks deques again
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this](){ return stopping_ || queuedTasks_ > 0; });
+        if (stopping_ && queuedTasks_ == 0) return;
+    }
+}
+
+bool WorkStealingThreadPool::popOwn(uint32_t threadIndex, Task& task)
+{
+    TaskDeque& deque = *deques_[threadIndex];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.tasks.empty()) return false;
+
+    task = std::move(deque.tasks.back());
+    deque.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingThreadPool::steal(uint32_t threadIndex, Task& task)
+{
+    for (uint32_t offset = 1; offset < deques_.size(); ++offset)
+    {
+        TaskDeque& deque = *deques_[(threadIndex + offset) % deques_.size()];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if (deque.tasks.empty()) continue;
+
+        task = std::move(deque.tasks.front());
+        deque.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+} // namespace ThreadPool
@@ -0,0 +1,81 @@
+#include "ThreadPool/BlockingQueue.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(BlockingQueueSuite, ZeroCapacityIsRoundedUp)
+{
+    const ThreadPool::BlockingQueue<int> queue(0);
+
+    ASSERT_EQ(1, queue.getCapacity());
+}
+
+TEST(BlockingQueueSuite, PopReturnsElementsInOrder)
+{
+    ThreadPool::BlockingQueue<std::unique_ptr<int>> queue(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(queue.push(std::make_unique<int>(i)));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        std::optional<std::unique_ptr<int>> element = queue.pop();
+        ASSERT_TRUE(element.has_value());
+        ASSERT_EQ(i, **element);
+    }
+}
+
+TEST(BlockingQueueSuite, CloseDrainsRemainingElements)
+{
+    ThreadPool::BlockingQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+    queue.close();
+
+    ASSERT_FALSE(queue.push(3));
+    ASSERT_EQ(1, queue.pop());
+    ASSERT_EQ(2, queue.pop());
+    ASSERT_EQ(std::nullopt, queue.pop());
+}
+
+TEST(BlockingQueueSuite, CloseWakesBlockedConsumer)
+{
+    ThreadPool::BlockingQueue<int> queue(1);
+    std::thread consumer([&queue](){ ASSERT_EQ(std::nullopt, queue.pop()); });
+
+    queue.close();
+    consumer.join();
+}
+
+TEST(BlockingQueueSuite, ProducerIsBoundedByCapacity)
+{
+    constexpr uint32_t capacity = 3;
+    constexpr int elementsCount = 1000;
+    ThreadPool::BlockingQueue<int> queue(capacity);
+    std::atomic<int> pushed = 0;
+    std::atomic<int> popped = 0;
+
+    std::thread producer([&](){
+        for (int i = 0; i < elementsCount; ++i)
+        {
+            queue.push(int(i));
+            pushed.fetch_add(1);
+        }
+        queue.close();
+    });
+
+    int expected = 0;
+    while (std::optional<int> element = queue.pop())
+    {
+        popped.fetch_add(1);
+        ASSERT_LE(pushed.load() - popped.load(), static_cast<int>(capacity));
+        ASSERT_EQ(expected++, *element);
+    }
+    producer.join();
+
+    ASSERT_EQ(elementsCount, expected);
+}
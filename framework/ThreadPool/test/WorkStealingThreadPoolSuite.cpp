@@ -0,0 +1,80 @@
+#include "ThreadPool/WorkStealingThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+
+TEST(WorkStealingThreadPoolSuite, DefaultThreadsCount)
+{
+    const ThreadPool::WorkStealingThreadPool threadPool;
+
+    ASSERT_GE(threadPool.getThreadsCount(), 1);
+}
+
+TEST(WorkStealingThreadPoolSuite, ExplicitThreadsCount)
+{
+    const ThreadPool::WorkStealingThreadPool threadPool(3);
+
+    ASSERT_EQ(3, threadPool.getThreadsCount());
+}
+
+TEST(WorkStealingThreadPoolSuite, DestructorRunsAllSubmittedTasks)
+{
+    constexpr uint32_t tasksCount = 10000;
+    std::atomic<uint32_t> executed = 0;
+    {
+        ThreadPool::WorkStealingThreadPool threadPool(4);
+        for (uint32_t i = 0; i < tasksCount; ++i)
+        {
+            threadPool.submit([&executed](){ executed.fetch_add(1); });
+        }
+    }
+
+    ASSERT_EQ(tasksCount, executed.load());
+}
+
+TEST(WorkStealingThreadPoolSuite, TasksSubmittedFromTasks)
+{
+    constexpr uint32_t parentsCount = 16;
+    constexpr uint32_t childrenCount = 64;
+    std::atomic<uint32_t> executed = 0;
+    {
+        ThreadPool::WorkStealingThreadPool threadPool(4);
+        for (uint32_t i = 0; i < parentsCount; ++i)
+        {
+            threadPool.submit([&threadPool, &executed](){
+                for (uint32_t j = 0; j < childrenCount; ++j)
+                {
+                    threadPool.submit([&executed](){ executed.fetch_add(1); });
+                }
+            });
+        }
+    }
+
+    ASSERT_EQ(parentsCount * childrenCount, executed.load());
+}
+
+TEST(WorkStealingThreadPoolSuite, IdleThreadsStealTasks)
+{
+    constexpr uint32_t threadsCount = 4;
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    {
+        ThreadPool::WorkStealingThreadPool threadPool(threadsCount);
+        // all children are pushed to the deque of a single thread, the other threads can only steal them
+        threadPool.submit([&](){
+            for (uint32_t i = 0; i < threadsCount * 4; ++i)
+            {
+                threadPool.submit([&](){
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    std::lock_guard<std::mutex> lock(mutex);
+                    threadIds.insert(std::this_thread::get_id());
+                });
+            }
+        });
+    }
+
+    ASSERT_GT(threadIds.size(), 1);
+}
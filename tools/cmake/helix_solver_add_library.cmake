@@ -1,7 +1,7 @@
 function(helix_solver_add_library target)
     cmake_parse_arguments(
         ARG # prefix of output variables
-        "APPLICATION;SYCL;UNIT_TEST"  # bolean arguments
+        "APPLICATION;NO_SYCL;SYCL;UNIT_TEST"  # bolean arguments
         "LOCATION;TYPE"  # single value arguments
         "INCLUDE;INTERFACE;PRIVATE;PUBLIC;SRC"  # list as a value arguments
         ${ARGN} # arguments to parse
@@ -11,6 +11,11 @@ function(helix_solver_add_library target)
 
     set(SRC_FILES ${ARG_SRC})
 
+    if(ARG_UNIT_TEST AND NOT GTest_FOUND)
+        message(STATUS "GTest not found, skipping UNIT_TEST ${TARGET}.")
+        return()
+    endif()
+
     if(ARG_UNIT_TEST)
         if(NOT ARG_LOCATION)
             message(FATAL_ERROR "LOCATION not provided for UNIT_TEST ${TARGET}. Provide LOCATION as a relative path from project's root directory to the directory containing ${TARGET}.")
@@ -35,7 +40,8 @@ function(helix_solver_add_library target)
         add_sycl_to_target(TARGET ${TARGET} SOURCES ${SRC_FILES})
     endif()
 
-    if(NOT DEFINED DISABLE_SYCL)
+    # NO_SYCL targets are always built with their non-SYCL code paths
+    if(NOT DEFINED DISABLE_SYCL AND NOT ARG_NO_SYCL)
         target_compile_definitions(${TARGET} PRIVATE USE_SYCL)
     endif()
 